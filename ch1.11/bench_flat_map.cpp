@@ -0,0 +1,125 @@
+/**
+ * 《AnyStringMap与FlatStringMap》
+ * 模拟标签索引：随机生成若干个长度为8~40的标签，每个标签对应1~8个文档编号(int)，所有的(标签, 文档编号)以随机的顺序给出。分别构造
+ * AnyStringMap<int>(std::map<std::string, std::vector<int>>)和通过Builder构造FlatStringMap<int>，输出：
+ *   1.build：从无序的键值对构造完成所需的时间。
+ *   2.bytes/key：构造完成后堆内存的增量(mallinfo2，包括malloc自身的开销)除以键的数量。
+ *   3.find hit/miss：以随机顺序查找存在和不存在的键，每秒完成的查找次数，命中时累加对应值的个数。
+ *   4.iterate：按顺序遍历所有的键和值，每秒访问的值的个数。
+ * 用法：bench_flat_map.exe [键的数量]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <malloc.h>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "flat_string_map.hpp"
+
+template<typename T>
+using AnyStringMap = std::map<std::string, std::vector<T>>;
+
+/* 大块内存通过mmap分配，不计入uordblks */
+std::size_t heapInUse(){
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template<typename F>
+double seconds(F &&f){
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> s = std::chrono::steady_clock::now() - begin;
+    return s.count();
+}
+
+std::string randomTag(std::mt19937_64 &rng){
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789:_-";
+    std::string tag(8 + rng() % 33, ' ');
+    for(char &c : tag) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+    return tag;
+}
+
+/* 不同的容器使用相同的查找和遍历代码 */
+template<typename Map>
+std::size_t lookup(const Map &map, const std::vector<std::string> &keys){
+    std::size_t found = 0;
+    for(const std::string &key : keys){
+        auto it = map.find(key);
+        if(it != map.end()) found += it->second.size();
+    }
+    return found;
+}
+
+template<typename Map>
+long long iterate(const Map &map){
+    long long sum = 0;
+    for(const auto &[key, values] : map){
+        sum += static_cast<long long>(key.size());
+        for(int value : values) sum += value;
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[]){
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::string> tags;
+    tags.reserve(n);
+    {
+        AnyStringMap<int> unique;
+        while(tags.size() < n){
+            std::string tag = randomTag(rng);
+            if(unique.emplace(tag, std::vector<int>()).second) tags.push_back(std::move(tag));
+        }
+    }
+    std::vector<std::pair<std::uint32_t, int>> pairs;
+    for(std::uint32_t i = 0; i < n; ++i){
+        for(std::size_t k = 1 + rng() % 8; k > 0; --k) pairs.emplace_back(i, static_cast<int>(rng() % 10000000));
+    }
+    std::shuffle(pairs.begin(), pairs.end(), rng);
+
+    std::vector<std::string> hits = tags;
+    std::shuffle(hits.begin(), hits.end(), rng);
+    std::vector<std::string> misses;
+    misses.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) misses.push_back(randomTag(rng) + "#");
+    const double valueCount = static_cast<double>(pairs.size());
+
+    std::cout << n << " keys, " << pairs.size() << " values" << std::endl;
+    std::cout << "map\tbuild(s)\tbytes/key\tfind hit(M/s)\tfind miss(M/s)\titerate(M values/s)" << std::endl;
+
+    auto report = [&](const char *name, double build, std::size_t bytes, const auto &map){
+        std::size_t found = 0, missed = 0;
+        long long sum = 0;
+        const double hit = seconds([&]{ found = lookup(map, hits); });
+        const double miss = seconds([&]{ missed = lookup(map, misses); });
+        const double walk = seconds([&]{ sum = iterate(map); });
+        std::cout << name << "\t" << build << "\t" << static_cast<double>(bytes) / n << "\t" << n / hit / 1e6 << "\t"
+                  << n / miss / 1e6 << "\t" << valueCount / walk / 1e6 << "\t(check " << found << " " << missed << " " << sum << ")" << std::endl;
+    };
+
+    {
+        const std::size_t before = heapInUse();
+        AnyStringMap<int> map;
+        const double build = seconds([&]{ for(const auto &[tag, value] : pairs) map[tags[tag]].push_back(value); });
+        report("std::map", build, heapInUse() - before, map);
+    }
+    {
+        const std::size_t before = heapInUse();
+        FlatStringMap<int> map;
+        const double build = seconds([&]{
+            FlatStringMap<int>::Builder builder;
+            builder.reserve(pairs.size(), pairs.size() * 24);
+            for(const auto &[tag, value] : pairs) builder.add(tags[tag], value);
+            map = builder.build();
+        });
+        report("FlatStringMap", build, heapInUse() - before, map);
+    }
+}
@@ -0,0 +1,294 @@
+#ifndef FLAT_STRING_MAP_HPP
+#define FLAT_STRING_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * 《扁平的AnyStringMap》
+ * AnyStringMap<T>即std::map<std::string, std::vector<T>>，每个键都需要分配一个树节点，超过短字符串长度的键还需要为std::string分配一次内存，
+ * 非空的std::vector<T>也需要分配一次内存，这些内存分散在堆中，遍历和查找时几乎每一步都会访问一段新的内存。FlatStringMap<T>构造完成后不再修改，
+ * 所有数据保存在四段连续的内存中：
+ *   1.m_arena：按照字典序依次存放所有的键，m_keyOffsets[i]和m_keyOffsets[i+1]之间是第i个键。
+ *   2.m_values：按照键的顺序依次存放所有的值，m_valueOffsets[i]和m_valueOffsets[i+1]之间是第i个键对应的值。
+ *   3.m_index：以线性探测的开放寻址哈希表作为索引，槽位中保存键的序号加一(0表示空槽)，装载因子不超过1/2。find、count和at通过哈希索引查找，
+ *     lower_bound在有序的键中二分查找。
+ * 遍历的顺序与std::map相同，元素为std::pair<std::string_view, ValueRange>，ValueRange是指向m_values的只读范围。键和值的总数都不能超过2^32-1。
+ * 构造FlatStringMap的方式有两种：从已有的AnyStringMap<T>转换，或者通过Builder以任意顺序添加键值对，build时按照键排序并把相同键的值合并到一起，
+ * 同一个键的值保持添加的顺序。
+ */
+template<typename T>
+class FlatStringMap{
+public:
+    /* 一个键对应的所有值 */
+    class ValueRange{
+    public:
+        ValueRange() = default;
+        ValueRange(const T *first, const T *last) : m_first(first), m_last(last){}
+
+        const T* begin() const { return m_first; }
+        const T* end() const { return m_last; }
+        const T* data() const { return m_first; }
+        std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+        bool empty() const { return m_first == m_last; }
+        const T& operator[](std::size_t i) const { return m_first[i]; }
+        const T& front() const { return *m_first; }
+        const T& back() const { return m_last[-1]; }
+
+    private:
+        const T *m_first = nullptr;
+        const T *m_last = nullptr;
+    };
+
+    using key_type = std::string_view;
+    using mapped_type = ValueRange;
+    using value_type = std::pair<std::string_view, ValueRange>;
+    using size_type = std::size_t;
+
+    /* 迭代器按值返回value_type，operator->通过一个临时对象访问其成员 */
+    class const_iterator{
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = FlatStringMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        struct pointer{
+            value_type value;
+            const value_type* operator->() const { return &value; }
+        };
+
+        const_iterator() = default;
+        const_iterator(const FlatStringMap *map, std::size_t pos) : m_map(map), m_pos(pos){}
+
+        reference operator*() const { return value_type(m_map->key(m_pos), m_map->values(m_pos)); }
+        pointer operator->() const { return pointer{**this}; }
+        const_iterator& operator++() { ++m_pos; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++m_pos; return old; }
+        const_iterator& operator--() { --m_pos; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --m_pos; return old; }
+
+        /* 元素在有序的键中的序号 */
+        std::size_t position() const { return m_pos; }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) { return lhs.m_pos == rhs.m_pos; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return lhs.m_pos != rhs.m_pos; }
+
+    private:
+        const FlatStringMap *m_map = nullptr;
+        std::size_t m_pos = 0;
+    };
+    using iterator = const_iterator;
+
+    class Builder;
+
+    FlatStringMap() = default;
+    explicit FlatStringMap(const std::map<std::string, std::vector<T>> &map);
+
+    std::size_t size() const { return m_keyOffsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+    std::size_t valueCount() const { return m_values.size(); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    const_iterator find(std::string_view key) const { return const_iterator(this, findIndex(key)); }
+    std::size_t count(std::string_view key) const { return findIndex(key) != size(); }
+    bool contains(std::string_view key) const { return findIndex(key) != size(); }
+
+    /* 与std::map::at相同，键不存在时抛出std::out_of_range */
+    ValueRange at(std::string_view key) const{
+        const std::size_t pos = findIndex(key);
+        if(pos == size()) throw std::out_of_range("FlatStringMap::at: key not found");
+        return values(pos);
+    }
+
+    /* 第一个不小于key的键，可用于前缀查询 */
+    const_iterator lower_bound(std::string_view key) const;
+
+    std::string_view key(std::size_t pos) const{
+        return std::string_view(m_arena.data() + m_keyOffsets[pos], m_keyOffsets[pos + 1] - m_keyOffsets[pos]);
+    }
+
+    ValueRange values(std::size_t pos) const{
+        return ValueRange(m_values.data() + m_valueOffsets[pos], m_values.data() + m_valueOffsets[pos + 1]);
+    }
+
+    /* 四段内存的总字节数 */
+    std::size_t memoryUsage() const{
+        return m_arena.capacity() + (m_keyOffsets.capacity() + m_valueOffsets.capacity() + m_index.capacity()) * sizeof(std::uint32_t) +
+               m_values.capacity() * sizeof(T);
+    }
+
+private:
+    static std::size_t hash(std::string_view key) { return std::hash<std::string_view>()(key); }
+
+    /* 追加一个大于之前所有键的键，values已经追加到m_values的末尾 */
+    void append(std::string_view key);
+    void buildIndex();
+    std::size_t findIndex(std::string_view key) const;
+
+    std::string m_arena;
+    std::vector<std::uint32_t> m_keyOffsets{0};
+    std::vector<std::uint32_t> m_valueOffsets{0};
+    std::vector<T> m_values;
+    std::vector<std::uint32_t> m_index = std::vector<std::uint32_t>(2, 0);
+};
+
+//===============Builder===============
+/* 以任意顺序添加键值对，build时一次性排序 */
+template<typename T>
+class FlatStringMap<T>::Builder{
+public:
+    void reserve(std::size_t pairs, std::size_t keyBytes){
+        m_pending.reserve(pairs);
+        m_values.reserve(pairs);
+        m_arena.reserve(keyBytes);
+    }
+
+    void add(std::string_view key, const T &value){
+        m_pending.push_back(Pending{prefix(key), m_arena.size(), key.size(), m_values.size()});
+        m_arena.append(key);
+        m_values.push_back(value);
+    }
+
+    void add(std::string_view key, T &&value){
+        m_pending.push_back(Pending{prefix(key), m_arena.size(), key.size(), m_values.size()});
+        m_arena.append(key);
+        m_values.push_back(std::move(value));
+    }
+
+    FlatStringMap build();
+
+private:
+    /* 排序时先比较键的前8个字节，只有前缀相同时才需要访问m_arena */
+    struct Pending{
+        std::uint64_t prefix;
+        std::size_t keyOffset;
+        std::size_t keyLength;
+        std::size_t value;
+    };
+
+    /* 以大端序组合前8个字节，不足8个字节时以0补齐，整数的大小关系与字典序一致 */
+    static std::uint64_t prefix(std::string_view key){
+        std::uint64_t result = 0;
+        for(std::size_t i = 0; i < 8; ++i){
+            result = (result << 8) | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0u);
+        }
+        return result;
+    }
+
+    std::string_view key(const Pending &p) const { return std::string_view(m_arena.data() + p.keyOffset, p.keyLength); }
+
+    std::string m_arena;
+    std::vector<Pending> m_pending;
+    std::vector<T> m_values;
+};
+
+template<typename T>
+FlatStringMap<T> FlatStringMap<T>::Builder::build(){
+    /* 稳定排序使同一个键的值保持添加的顺序 */
+    std::stable_sort(m_pending.begin(), m_pending.end(), [this](const Pending &lhs, const Pending &rhs){
+        if(lhs.prefix != rhs.prefix) return lhs.prefix < rhs.prefix;
+        return key(lhs) < key(rhs);
+    });
+
+    FlatStringMap map;
+    map.m_values.reserve(m_values.size());
+    for(std::size_t i = 0; i < m_pending.size();){
+        const std::string_view current = key(m_pending[i]);
+        for(; i < m_pending.size() && key(m_pending[i]) == current; ++i) map.m_values.push_back(std::move(m_values[m_pending[i].value]));
+        map.append(current);
+    }
+    map.m_arena.shrink_to_fit();
+    map.m_keyOffsets.shrink_to_fit();
+    map.m_valueOffsets.shrink_to_fit();
+    map.buildIndex();
+
+    m_arena.clear();
+    m_pending.clear();
+    m_values.clear();
+    return map;
+}
+
+//===============FlatStringMap===============
+template<typename T>
+FlatStringMap<T>::FlatStringMap(const std::map<std::string, std::vector<T>> &map){
+    std::size_t keyBytes = 0;
+    std::size_t valueCount = 0;
+    for(const auto &[key, values] : map){
+        keyBytes += key.size();
+        valueCount += values.size();
+    }
+    m_arena.reserve(keyBytes);
+    m_keyOffsets.reserve(map.size() + 1);
+    m_valueOffsets.reserve(map.size() + 1);
+    m_values.reserve(valueCount);
+
+    for(const auto &[key, values] : map){
+        m_values.insert(m_values.end(), values.begin(), values.end());
+        append(key);
+    }
+    buildIndex();
+}
+
+template<typename T>
+void FlatStringMap<T>::append(std::string_view key){
+    if(m_arena.size() + key.size() > UINT32_MAX || m_values.size() > UINT32_MAX || m_keyOffsets.size() >= UINT32_MAX){
+        throw std::length_error("FlatStringMap: too many keys or values");
+    }
+    m_arena.append(key);
+    m_keyOffsets.push_back(static_cast<std::uint32_t>(m_arena.size()));
+    m_valueOffsets.push_back(static_cast<std::uint32_t>(m_values.size()));
+}
+
+template<typename T>
+void FlatStringMap<T>::buildIndex(){
+    std::size_t capacity = 2;
+    while(capacity < size() * 2) capacity *= 2;
+    m_index.assign(capacity, 0);
+
+    const std::size_t mask = capacity - 1;
+    for(std::size_t pos = 0; pos < size(); ++pos){
+        std::size_t slot = hash(key(pos)) & mask;
+        while(m_index[slot] != 0) slot = (slot + 1) & mask;
+        m_index[slot] = static_cast<std::uint32_t>(pos + 1);
+    }
+}
+
+template<typename T>
+std::size_t FlatStringMap<T>::findIndex(std::string_view key) const{
+    const std::size_t mask = m_index.size() - 1;
+    for(std::size_t slot = hash(key) & mask; m_index[slot] != 0; slot = (slot + 1) & mask){
+        const std::size_t pos = m_index[slot] - 1;
+        if(this->key(pos) == key) return pos;
+    }
+    return size();
+}
+
+template<typename T>
+typename FlatStringMap<T>::const_iterator FlatStringMap<T>::lower_bound(std::string_view key) const{
+    std::size_t first = 0;
+    std::size_t count = size();
+    while(count > 0){
+        const std::size_t half = count / 2;
+        if(this->key(first + half) < key){
+            first += half + 1;
+            count -= half + 1;
+        }else{
+            count = half;
+        }
+    }
+    return const_iterator(this, first);
+}
+
+#endif
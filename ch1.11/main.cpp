@@ -0,0 +1,75 @@
+/**
+ * 《类型别名与别名模板》
+ * 1.关键字typedef和using(C++11引入)都可以为已有的类型定义别名，类型和它的别名是等价的，可以互相替换使用。使用typedef定义的别名被称为
+ *   类型别名(Typedefs)，使用using定义的别名被称为别名声明(Alias declarations)。[例1]
+ * 2.using定义的别名可以模板化，定义别名的同时声明模板参数，由别名的使用者提供具体的类型，例如AnyStringMap<T>。[例2]
+ * 3.AnyStringMap<T>的每个键都需要一个树节点、一个std::string和一个std::vector，flat_string_map.hpp中的FlatStringMap<T>把所有的键和值分别
+ *   存放在连续的内存中，适用于构造之后只做查找和遍历的场合。[例3]
+ */
+#include <iostream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "flat_string_map.hpp"
+
+//===============例1===============
+/* 在实际情况下，为了避免名称冲突，同一个别名只能使用其中一种方式定义 */
+typedef unsigned long long UID;
+using UserID = unsigned long long;
+
+void needUID(UID uid){ std::cout << "uid: " << uid << std::endl; }
+
+void func1(){
+    UID uid1 = 2020939493UL;
+    unsigned long long uid2 = 2020939494UL;
+    UserID uid3 = 2020939495UL;
+    needUID(uid1); //OK
+    needUID(uid2); //OK
+    needUID(uid3); //OK，UID与UserID都是unsigned long long
+    std::cout << std::is_same<UID, UserID>::value << std::endl;
+}
+
+//===============例2===============
+template<typename T>
+using AnyStringMap = std::map<std::string, std::vector<T>>;
+
+void func2(){
+    AnyStringMap<int> istrmap;      //等同于std::map<std::string, std::vector<int>>
+    AnyStringMap<double> dstrmap;   //等同于std::map<std::string, std::vector<double>>
+    istrmap["primes"] = {2, 3, 5, 7};
+    dstrmap["constants"] = {3.14, 2.72};
+    std::cout << std::is_same<AnyStringMap<int>, std::map<std::string, std::vector<int>>>::value << std::endl;
+}
+
+//===============例3===============
+void func3(){
+    /* 以任意顺序添加标签和文档编号，build时按标签排序并合并 */
+    FlatStringMap<int>::Builder builder;
+    builder.add("tag:cpp", 1);
+    builder.add("tag:rust", 2);
+    builder.add("tag:cpp", 3);
+    builder.add("tag:go", 4);
+    builder.add("tag:cpp", 5);
+    const FlatStringMap<int> tags = builder.build();
+
+    for(const auto &[tag, docs] : tags){
+        std::cout << tag << ":";
+        for(int doc : docs) std::cout << " " << doc;
+        std::cout << std::endl;
+    }
+
+    std::cout << "tag:cpp has " << tags.at("tag:cpp").size() << " docs, tag:java " << tags.count("tag:java") << std::endl;
+    std::cout << "first tag >= \"tag:d\": " << tags.lower_bound("tag:d")->first << std::endl;
+
+    /* 也可以从已有的AnyStringMap转换 */
+    AnyStringMap<double> dstrmap{{"constants", {3.14, 2.72}}, {"empty", {}}};
+    const FlatStringMap<double> flat(dstrmap);
+    std::cout << flat.size() << " keys, " << flat.valueCount() << " values, " << flat.at("constants")[1] << std::endl;
+}
+
+int main(void){
+    func1();
+    func2();
+    func3();
+}
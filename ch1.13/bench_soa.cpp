@@ -0,0 +1,104 @@
+/**
+ * 《AoS与SoA》
+ * 对N个StringPair<double>的value求和，输出每秒处理的元素个数以及每秒扫描的数据量(按照每种方式实际需要读取的字节数计算)：
+ *   1.AoS：std::vector<StringPair<double>>，每个元素40字节，扫描value时name也会被读入缓存。
+ *   2.SoA column：SoaVector<StringPair<double>>的column<1>()，只读取8字节的value。
+ *   3.SoA proxy：通过行代理v[i].value访问，检查代理是否带来额外的开销。
+ *   4.x4：以4个独立的累加器求和。浮点加法不满足结合律，编译器不会自动拆分单个累加器，单个累加器的求和受限于加法的延迟；拆分之后多个加法
+ *     可以同时进行。AoS的扫描受限于内存带宽，拆分累加器没有帮助。
+ * 两种布局依次构造、测试并释放，避免同时占用两份内存。N为10^8时每种布局约需4GB内存。
+ * 用法：bench_soa.exe [元素的数量] [重复次数]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "soa_vector.hpp"
+
+template<typename T>
+struct StringPair{
+    std::string name;
+    T value;
+};
+
+template<typename T>
+struct SoaRef<StringPair<T>>{
+    std::string &name;
+    T &value;
+};
+
+template<typename T>
+struct SoaRef<const StringPair<T>>{
+    const std::string &name;
+    const T &value;
+};
+
+/* name不超过短字符串的长度，不会分配额外的内存 */
+std::string nameOf(std::size_t i) { return "k" + std::to_string(i % 1000); }
+double valueOf(std::size_t i) { return static_cast<double>(i % 1024) * 0.5; }
+
+/* 4个独立的累加器，get(i)返回第i个value */
+template<typename Get>
+double sum4(std::size_t n, Get get){
+    double sums[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        sums[0] += get(i);
+        sums[1] += get(i + 1);
+        sums[2] += get(i + 2);
+        sums[3] += get(i + 3);
+    }
+    for(; i < n; ++i) sums[0] += get(i);
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+template<typename F>
+void report(const char *name, std::size_t n, std::size_t bytesPerElement, int reps, F &&sum){
+    double result = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; ++r) result += sum();
+    std::chrono::duration<double> s = std::chrono::steady_clock::now() - begin;
+    const double elements = static_cast<double>(n) * reps;
+    std::cout << name << "\t" << elements / s.count() / 1e6 << "\t" << elements * bytesPerElement / s.count() / 1e9
+              << "\t(sum " << result / reps << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::cout << n << " x StringPair<double> (" << sizeof(StringPair<double>) << " bytes)" << std::endl;
+    std::cout << "layout\tM elements/s\tGB/s" << std::endl;
+    {
+        std::vector<StringPair<double>> aos;
+        aos.reserve(n);
+        for(std::size_t i = 0; i < n; ++i) aos.push_back({nameOf(i), valueOf(i)});
+        report("AoS", n, sizeof(StringPair<double>), reps, [&]{
+            double sum = 0;
+            for(const StringPair<double> &pair : aos) sum += pair.value;
+            return sum;
+        });
+        report("AoS x4", n, sizeof(StringPair<double>), reps, [&]{ return sum4(n, [&](std::size_t i){ return aos[i].value; }); });
+    }
+    {
+        SoaVector<StringPair<double>> soa;
+        soa.reserve(n);
+        for(std::size_t i = 0; i < n; ++i) soa.emplace_back(nameOf(i), valueOf(i));
+        report("SoA column", n, sizeof(double), reps, [&]{
+            double sum = 0;
+            for(double value : soa.column<1>()) sum += value;
+            return sum;
+        });
+        report("SoA proxy", n, sizeof(double), reps, [&]{
+            const SoaVector<StringPair<double>> &view = soa;
+            double sum = 0;
+            for(std::size_t i = 0; i < view.size(); ++i) sum += view[i].value;
+            return sum;
+        });
+        report("SoA column x4", n, sizeof(double), reps, [&]{
+            const SoaSpan<const double> values = static_cast<const SoaVector<StringPair<double>>&>(soa).column<1>();
+            return sum4(values.size(), [&](std::size_t i){ return values[i]; });
+        });
+    }
+}
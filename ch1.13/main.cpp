@@ -5,10 +5,12 @@
  *   2.没有private、protected的非静态成员
  *   3.没有虚函数、虚基类、以private或者protected方式继承的基类
  * 这样的聚合体可以使用列表式初始化“{ }”对其中的每个成员按照声明顺序进行初始化。
+ * 大量的聚合体可以按成员拆分存放在soa_vector.hpp的SoaVector中，只扫描其中一个成员时不必读取其他成员。[例3]
  */
 
  #include <string>
 #include <iostream>
+#include "soa_vector.hpp"
 
 //========================================
 /**
@@ -48,7 +50,45 @@ void func2(){
     StringPair strPair = {"name", "Tom.Smith"};
 }
 
+//========================================
+/**
+ * 《按成员拆分存放聚合体》
+ * SoaVector<StringPair<T>>把所有的name和所有的value分别存放在两个std::vector中。为StringPair特例化行代理SoaRef之后，v[i].name和v[i].value
+ * 直接引用两列中的元素；column<1>()返回所有value组成的连续范围。
+ */
+template<typename T>
+struct SoaRef<StringPair<T>>{
+    std::string &name;
+    T &value;
+};
+
+template<typename T>
+struct SoaRef<const StringPair<T>>{
+    const std::string &name;
+    const T &value;
+};
+
+void func3(){
+    SoaVector<StringPair<double>> pairs;
+    pairs.push_back({"Height", 180.0});
+    pairs.push_back({"Weight", 72.5});
+    pairs.emplace_back("Age", 30.0);
+
+    /* 通过行代理修改value列中的元素 */
+    pairs[1].value += 0.5;
+    for(auto pair : pairs) std::cout << pair.name << ": " << pair.value << std::endl;
+
+    /* 只扫描value列 */
+    double sum = 0;
+    for(double value : pairs.column<1>()) sum += value;
+    std::cout << "sum: " << sum << std::endl;
+
+    StringPair<double> copy = pairs.row(0);
+    std::cout << copy.name << " " << copy.value << std::endl;
+}
+
 int main(void){
     func1();
     func2();
+    func3();
 }
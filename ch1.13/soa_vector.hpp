@@ -0,0 +1,180 @@
+#ifndef SOA_VECTOR_HPP
+#define SOA_VECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../ch5.3/aggregate_fields.hpp"
+
+/**
+ * 《按成员拆分存放聚合体》
+ * std::vector<StringPair<T>>中每个元素的name和value相邻存放(AoS，Array of Structures)，只扫描value时，每读取8字节的double就要把32字节的
+ * std::string一起带入缓存。SoaVector<A>把聚合体A的每个成员分别存放在一个std::vector中(SoA，Structure of Arrays)：
+ *   1.成员的数量和类型通过ch5.3/aggregate_fields.hpp中的fieldCount和tieFields获得：AnyField检测花括号初始化能够接受的初始值个数，结构化绑定取出每个成员。因此A必须
+ *     是成员不超过MAX_FIELDS个的聚合体，并且成员不能是C风格数组或引用。
+ *   2.column<I>()返回第I个成员组成的连续范围SoaSpan，可以直接交给编译器向量化的循环。
+ *   3.operator[]返回行代理SoaRef<A>，只读访问时为SoaRef<const A>。SoaRef的主模板通过get<I>()访问成员，也可以转换为A或者从A赋值。如果希望像
+ *     v[i].value这样按名称访问成员，可以为A特例化SoaRef，将其定义为以引用为成员的聚合体，成员的顺序与A相同。SoaVector以
+ *     SoaRef<A>{column0[i], column1[i], ...}构造行代理，主模板和这样的特例化都可以通过这种方式构造。
+ *   4.push_back和emplace_back依次追加每一列，某一列追加失败时撤销已经追加的列，使各列的长度保持一致。
+ */
+
+//===============列的类型===============
+template<typename Refs>
+struct SoaFieldsOf;
+
+template<typename... F>
+struct SoaFieldsOf<std::tuple<F&...>>{
+    using Columns = std::tuple<std::vector<F>...>;
+    using Refs = std::tuple<F&...>;
+    using ConstRefs = std::tuple<const F&...>;
+
+    template<std::size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<F...>>;
+};
+
+template<typename A>
+using SoaFields = SoaFieldsOf<decltype(tieFields(std::declval<A&>()))>;
+
+/* 一列的连续范围 */
+template<typename T>
+class SoaSpan{
+public:
+    SoaSpan(T *data, std::size_t size) : m_data(data), m_size(size){}
+
+    T* begin() const { return m_data; }
+    T* end() const { return m_data + m_size; }
+    T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T& operator[](std::size_t i) const { return m_data[i]; }
+
+private:
+    T *m_data;
+    std::size_t m_size;
+};
+
+//===============行代理===============
+template<typename A>
+class SoaRef{
+    using Row = std::remove_const_t<A>;
+    using Refs = std::conditional_t<std::is_const_v<A>, typename SoaFields<Row>::ConstRefs, typename SoaFields<Row>::Refs>;
+
+public:
+    /* 限制参数能够构造Refs，以免拷贝一个非const的SoaRef时选中这个构造函数 */
+    template<typename... R, typename = std::enable_if_t<std::is_constructible_v<Refs, R&...>>>
+    SoaRef(R&... refs) : m_refs(refs...){}
+
+    template<std::size_t I>
+    auto& get() const { return std::get<I>(m_refs); }
+
+    /* 拷贝出一个完整的A */
+    operator Row() const { return std::apply([](const auto&... fields){ return Row{fields...}; }, m_refs); }
+
+    /* 与std::vector<bool>::reference相同，赋值修改的是被引用的元素 */
+    template<typename T = A, typename = std::enable_if_t<!std::is_const_v<T>>>
+    const SoaRef& operator=(const Row &row) const{
+        m_refs = tieFields(row);
+        return *this;
+    }
+
+private:
+    mutable Refs m_refs;
+};
+
+//===============SoaVector===============
+template<typename A>
+class SoaVector{
+    using Fields = SoaFields<A>;
+    static constexpr std::size_t FIELDS = fieldCount<A>();
+    using Indices = std::make_index_sequence<FIELDS>;
+
+public:
+    using value_type = A;
+    using reference = SoaRef<A>;
+    using const_reference = SoaRef<const A>;
+
+    template<typename Ref, typename Vec>
+    class Iterator{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = A;
+        using difference_type = std::ptrdiff_t;
+        using reference = Ref;
+        using pointer = void;
+
+        Iterator(Vec *vec, std::size_t pos) : m_vec(vec), m_pos(pos){}
+
+        Ref operator*() const { return (*m_vec)[m_pos]; }
+        Iterator& operator++() { ++m_pos; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++m_pos; return old; }
+
+        friend bool operator==(const Iterator &lhs, const Iterator &rhs) { return lhs.m_pos == rhs.m_pos; }
+        friend bool operator!=(const Iterator &lhs, const Iterator &rhs) { return lhs.m_pos != rhs.m_pos; }
+
+    private:
+        Vec *m_vec;
+        std::size_t m_pos;
+    };
+    using iterator = Iterator<reference, SoaVector>;
+    using const_iterator = Iterator<const_reference, const SoaVector>;
+
+    std::size_t size() const { return std::get<0>(m_columns).size(); }
+    bool empty() const { return size() == 0; }
+    void reserve(std::size_t n) { std::apply([n](auto&... columns){ (columns.reserve(n), ...); }, m_columns); }
+    void resize(std::size_t n) { std::apply([n](auto&... columns){ (columns.resize(n), ...); }, m_columns); }
+    void clear() { std::apply([](auto&... columns){ (columns.clear(), ...); }, m_columns); }
+    void pop_back() { std::apply([](auto&... columns){ (columns.pop_back(), ...); }, m_columns); }
+
+    void push_back(const A &row) { std::apply([this](const auto&... fields){ append(Indices(), fields...); }, tieFields(row)); }
+    void push_back(A &&row) { std::apply([this](auto&... fields){ append(Indices(), std::move(fields)...); }, tieFields(row)); }
+
+    /* 按照成员的顺序提供每个成员的值 */
+    template<typename... Args>
+    void emplace_back(Args&&... fields){
+        static_assert(sizeof...(Args) == FIELDS, "emplace_back: one argument per field");
+        append(Indices(), std::forward<Args>(fields)...);
+    }
+
+    reference operator[](std::size_t i) { return makeRef<reference>(*this, i, Indices()); }
+    const_reference operator[](std::size_t i) const { return makeRef<const_reference>(*this, i, Indices()); }
+
+    /* 拷贝出第i行 */
+    A row(std::size_t i) const { return makeRow(i, Indices()); }
+
+    template<std::size_t I>
+    SoaSpan<typename Fields::template Field<I>> column() { return {std::get<I>(m_columns).data(), size()}; }
+
+    template<std::size_t I>
+    SoaSpan<const typename Fields::template Field<I>> column() const { return {std::get<I>(m_columns).data(), size()}; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+private:
+    template<typename Ref, typename Vec, std::size_t... I>
+    static Ref makeRef(Vec &vec, std::size_t i, std::index_sequence<I...>) { return Ref{std::get<I>(vec.m_columns)[i]...}; }
+
+    template<std::size_t... I>
+    A makeRow(std::size_t i, std::index_sequence<I...>) const { return A{std::get<I>(m_columns)[i]...}; }
+
+    template<std::size_t... I, typename... V>
+    void append(std::index_sequence<I...>, V&&... values){
+        std::size_t pushed = 0;
+        try{
+            ((std::get<I>(m_columns).push_back(std::forward<V>(values)), ++pushed), ...);
+        }catch(...){
+            ((I < pushed ? std::get<I>(m_columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    typename Fields::Columns m_columns;
+};
+
+#endif
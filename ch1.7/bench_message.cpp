@@ -0,0 +1,155 @@
+/**
+ * 《operator<<与二进制编码》
+ * 发送方将消息写入一段发送缓冲区，接收方从中取出消息并读取内容，输出每秒处理的消息数以及每条消息被拷贝的字节数：
+ *   1.ostream：通过operator<<将消息格式化到std::ostringstream，调用str()取出文本作为发送的数据，接收方以std::istringstream解析文本。
+ *     格式化写入流缓冲区、str()和构造std::istringstream各拷贝一次文本。
+ *   2.encode：每条消息编码为一帧写入发送缓冲区，接收方decode后直接读取缓冲区中的数据。
+ *   3.encodeBatch：每BATCH条消息编码为一帧。
+ * 消息分别为24字节的Tick(可以平凡拷贝)以及平均32个字符的std::string。二进制编码只在encode时拷贝一次负载，解码不拷贝。
+ * 用法：bench_message.exe [消息的数量]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "message.hpp"
+
+struct Tick{
+    std::uint64_t id;
+    double price;
+    std::uint32_t quantity;
+    std::uint32_t side;
+};
+
+std::ostream& operator<<(std::ostream &os, const Tick &tick){
+    return os << tick.id << ' ' << tick.price << ' ' << tick.quantity << ' ' << tick.side;
+}
+
+std::istream& operator>>(std::istream &is, Tick &tick){
+    return is >> tick.id >> tick.price >> tick.quantity >> tick.side;
+}
+
+constexpr std::size_t BATCH = 256;
+
+/* 接收方读取的内容，用于确认三种方式得到相同的结果 */
+std::uint64_t checksum(const Tick &tick) { return tick.id + tick.quantity; }
+std::uint64_t checksum(std::string_view text) { return text.size() + static_cast<unsigned char>(text.back()); }
+
+struct Result{
+    double seconds;
+    std::uint64_t copied;
+    std::uint64_t sum;
+};
+
+template<typename F>
+Result timed(F &&f){
+    auto begin = std::chrono::steady_clock::now();
+    Result result = f();
+    std::chrono::duration<double> s = std::chrono::steady_clock::now() - begin;
+    result.seconds = s.count();
+    return result;
+}
+
+//===============ostream===============
+template<typename MT>
+Result viaOstream(const std::vector<Message<MT>> &msgs){
+    Result result{0, 0, 0};
+    std::ostringstream os;
+    MT received{};
+    for(const Message<MT> &msg : msgs){
+        os.str(std::string());
+        os << msg;
+        const std::string wire = os.str();
+        std::istringstream is(wire);
+        is >> received;
+        result.copied += 3 * wire.size();
+        result.sum += checksum(received);
+    }
+    return result;
+}
+
+//===============二进制===============
+/* 每条消息编码为一帧，发送缓冲区满时由接收方取出其中所有的帧 */
+template<typename MT>
+Result viaEncode(const std::vector<Message<MT>> &msgs, std::vector<std::uint64_t> &storage){
+    Result result{0, 0, 0};
+    char *buf = reinterpret_cast<char*>(storage.data());
+    const std::size_t capacity = storage.size() * sizeof(std::uint64_t);
+    auto drain = [&](std::size_t used){
+        for(std::size_t pos = 0; pos < used;){
+            DecodeResult<MT> decoded = decode<MT>(buf + pos, used - pos);
+            for(auto &&view : decoded.frame) result.sum += checksum(view);
+            pos += decoded.consumed;
+        }
+    };
+
+    std::size_t used = 0;
+    for(const Message<MT> &msg : msgs){
+        std::size_t n = encode(buf + used, capacity - used, msg);
+        if(n == 0){
+            drain(used);
+            used = 0;
+            n = encode(buf, capacity, msg);
+        }
+        used += n;
+        result.copied += WireTraits<MT>::size(msg.m_msg);
+    }
+    drain(used);
+    return result;
+}
+
+template<typename MT>
+Result viaEncodeBatch(const std::vector<Message<MT>> &msgs, std::vector<std::uint64_t> &storage){
+    Result result{0, 0, 0};
+    char *buf = reinterpret_cast<char*>(storage.data());
+    const std::size_t capacity = storage.size() * sizeof(std::uint64_t);
+    for(std::size_t first = 0; first < msgs.size(); first += BATCH){
+        const std::size_t count = std::min(BATCH, msgs.size() - first);
+        const std::size_t used = encodeBatch(buf, capacity, msgs.data() + first, count);
+        for(std::size_t i = first; i < first + count; ++i) result.copied += WireTraits<MT>::size(msgs[i].m_msg);
+
+        DecodeResult<MT> decoded = decode<MT>(buf, used);
+        for(auto &&view : decoded.frame) result.sum += checksum(view);
+    }
+    return result;
+}
+
+template<typename MT>
+void run(const char *name, const std::vector<Message<MT>> &msgs){
+    std::vector<std::uint64_t> storage(64 * 1024);
+    const Result results[] = {
+        timed([&]{ return viaOstream(msgs); }),
+        timed([&]{ return viaEncode(msgs, storage); }),
+        timed([&]{ return viaEncodeBatch(msgs, storage); }),
+    };
+    const char *paths[] = {"ostream", "encode", "encodeBatch"};
+    for(int i = 0; i < 3; ++i){
+        std::cout << name << "\t" << paths[i] << "\t" << msgs.size() / results[i].seconds / 1e6 << "\t"
+                  << static_cast<double>(results[i].copied) / msgs.size() << "\t(check " << results[i].sum - results[0].sum << ")" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]){
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<Message<Tick>> ticks;
+    std::vector<Message<std::string>> texts;
+    ticks.reserve(n);
+    texts.reserve(n);
+    for(std::size_t i = 0; i < n; ++i){
+        ticks.emplace_back(Tick{i, 100.0 + static_cast<double>(rng() % 10000) / 100, static_cast<std::uint32_t>(rng() % 1000), static_cast<std::uint32_t>(rng() % 2)});
+        std::string text(16 + rng() % 33, 'a');
+        for(char &c : text) c = static_cast<char>('a' + rng() % 26);
+        texts.emplace_back(text);
+    }
+
+    std::cout << "message\tpath\tMmsg/s\tcopied(bytes/msg)" << std::endl;
+    run("Tick", ticks);
+    run("string", texts);
+}
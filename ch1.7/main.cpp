@@ -0,0 +1,127 @@
+/**
+ * 《为类模板声明友元函数》
+ * 1.最简单的办法是直接在类模板中定义友元函数。这种友元函数虽然定义在类模板内部，但并不是类模板的成员函数，可以像普通的全局函数那样使用。[例1]
+ * 2.如果想要将友元函数的声明和定义分离，可以在类模板中声明一个友元函数模板，然后在类模板外部定义它。友元函数模板的模板参数不能与类模板的模板参数
+ *   同名，否则外层的模板参数会被遮蔽。[例2]
+ * 3.也可以先通过前向声明将友元函数声明为一个函数模板，然后在类模板中将它的特例化声明为友元，operator<<后紧跟的<MT>是特例化的标志，缺少它
+ *   就只是声明了一个新的非模板友元函数。[例3]
+ * 4.operator<<每次发送都需要格式化和拷贝，message.hpp为Message<MT>提供了直接写入调用者缓冲区的二进制编码，MT可以平凡拷贝时解码不拷贝数据。[例4]
+ */
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "message.hpp"
+
+//===============例1===============
+template<typename MT>
+struct Message1{
+    MT m_msg;
+    Message1(const MT &msg) : m_msg(msg){}
+
+    /* 直接在类模板中定义友元函数 */
+    friend std::ostream& operator<<(std::ostream &os, Message1<MT> &msg){
+        os << msg.m_msg;
+        return os;
+    }
+};
+
+void func1(){
+    Message1<const char*> msg{"Hello World"};
+    operator<<(std::cout, msg);  //也可以写为操作符形式std::cout << msg
+    std::cout << std::endl;
+}
+
+//===============例2===============
+template<typename MT>
+struct Message2{
+    MT m_msg;
+    Message2(const MT &msg) : m_msg(msg){}
+
+    /* 模板参数使用U而不是MT，否则会遮蔽外层的MT */
+    template<typename U>
+    friend std::ostream& operator<<(std::ostream &os, Message2<U> &msg);
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream &os, Message2<T> &msg){
+    os << msg.m_msg;
+    return os;
+}
+
+void func2(){
+    Message2<int> msg{42};
+    std::cout << msg << std::endl;
+}
+
+//===============例3===============
+/* 由于operator<<的参数会使用到Message3，因此也需要对Message3进行前向声明 */
+template<typename MT>
+struct Message3;
+
+template<typename T>
+std::ostream& operator<<(std::ostream&, Message3<T> &msg);
+
+template<typename MT>
+struct Message3{
+    MT m_msg;
+    Message3(const MT &msg) : m_msg(msg){}
+
+    friend std::ostream& operator<<<MT>(std::ostream &os, Message3<MT> &msg);
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream &os, Message3<T> &msg){
+    os << msg.m_msg;
+    return os;
+}
+
+void func3(){
+    Message3<double> msg{3.14};
+    std::cout << msg << std::endl;
+}
+
+//===============例4===============
+struct Tick{
+    std::uint64_t id;
+    double price;
+    std::uint32_t quantity;
+    std::uint32_t side;
+};
+
+std::ostream& operator<<(std::ostream &os, const Tick &tick){
+    return os << tick.id << ' ' << tick.price << ' ' << tick.quantity << ' ' << tick.side;
+}
+
+void func4(){
+    /* 缓冲区的起点需要按照WIRE_ALIGN对齐，std::vector<std::uint64_t>满足这个要求 */
+    std::vector<std::uint64_t> storage(64);
+    char *buf = reinterpret_cast<char*>(storage.data());
+    const std::size_t capacity = storage.size() * sizeof(std::uint64_t);
+
+    /* 一帧中包含三条Tick消息，通过一次memcpy写出 */
+    std::vector<Message<Tick>> ticks{Tick{1, 99.5, 100, 0}, Tick{2, 99.75, 20, 1}, Tick{3, 100.0, 5, 0}};
+    std::size_t used = encodeBatch(buf, capacity, ticks.data(), ticks.size());
+
+    /* 后面再追加一帧字符串消息 */
+    used += encode(buf + used, capacity - used, Message<const char*>{"Hello World"});
+
+    /* 解码得到的FrameView指向buf中的数据 */
+    DecodeResult<Tick> first = decode<Tick>(buf, used);
+    for(const Tick &tick : first.frame) std::cout << tick << std::endl;
+    std::cout << "ticks[1] is at buf + " << reinterpret_cast<const char*>(&first.frame[1]) - buf << std::endl;
+
+    DecodeResult<const char*> second = decode<const char*>(buf + first.consumed, used - first.consumed);
+    for(std::string_view text : second.frame) std::cout << text << std::endl;
+    std::cout << first.consumed << " + " << second.consumed << " = " << used << " bytes" << std::endl;
+
+    /* 数据不足一帧时consumed为0，等待接收更多数据 */
+    std::cout << "partial: " << decode<Tick>(buf, first.consumed - 1).consumed << std::endl;
+}
+
+int main(void){
+    func1();
+    func2();
+    func3();
+    func4();
+}
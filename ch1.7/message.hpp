@@ -0,0 +1,248 @@
+#ifndef MESSAGE_HPP
+#define MESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * 《Message的二进制编码》
+ * operator<<通过std::ostream发送Message时，每条消息都需要格式化为文本并在流缓冲区和std::string之间反复拷贝，接收方还需要重新解析文本。
+ * 这里为Message<MT>提供一种二进制格式，直接写入调用者提供的缓冲区：
+ *   1.数据由若干帧组成，每帧以8字节的WireHeader开头，记录负载的字节数和其中消息的条数，帧的总长度补齐到WIRE_ALIGN的整数倍。
+ *   2.MT可以平凡拷贝时，负载就是count个MT依次排列。encodeBatch通过一次memcpy写出整个Message<MT>数组，decode返回的FrameView直接指向
+ *     接收到的字节，不拷贝也不分配内存。只要缓冲区的起点按照WIRE_ALIGN对齐(new和malloc分配的内存都满足)，其中每一帧的负载都是对齐的。
+ *     alignof(MT)超过WIRE_ALIGN的MT在编译时报错。
+ *   3.MT为std::string、std::string_view或const char*时，每条消息编码为32位的长度和字符，FrameView中的元素是指向接收缓冲区的std::string_view。
+ *   4.encode和encodeBatch在缓冲区不足时返回0；decode在数据不足一帧时返回consumed为0的结果(例如只接收到部分数据)，数据格式错误时抛出
+ *     std::invalid_argument。
+ * 整数和浮点数以本机字节序编码，因此数据只能由相同平台、以相同MT编译的程序读取。FrameView在接收缓冲区被修改或释放后失效。
+ */
+
+//===============Message===============
+template<typename MT>
+struct Message{
+    MT m_msg;
+    Message(const MT &msg) : m_msg(msg){}
+
+    /* 直接在类模板中定义友元函数 */
+    friend std::ostream& operator<<(std::ostream &os, const Message<MT> &msg){
+        os << msg.m_msg;
+        return os;
+    }
+};
+
+//===============编码规则===============
+struct WireHeader{
+    std::uint32_t size;     //负载的字节数，不包括帧头和补齐的部分
+    std::uint32_t count;    //消息的条数
+};
+
+constexpr std::size_t WIRE_ALIGN = 8;
+
+constexpr std::size_t wirePadded(std::size_t n){
+    return (n + WIRE_ALIGN - 1) & ~(WIRE_ALIGN - 1);
+}
+
+/* 未特例化的MT不支持二进制编码 */
+template<typename MT, typename = void>
+struct WireTraits;
+
+/* 可以平凡拷贝的MT：按原样写出，读取时直接引用缓冲区中的对象。指针只在本进程内有意义，因此除字符串外不支持 */
+template<typename MT>
+struct WireTraits<MT, std::enable_if_t<std::is_trivially_copyable_v<MT> && !std::is_pointer_v<MT>>>{
+    /* 负载总是位于帧起点之后8字节处，帧的长度也只补齐到WIRE_ALIGN，因此对齐要求更高的MT(例如long double、alignas(16)的结构体)无法直接引用 */
+    static_assert(alignof(MT) <= WIRE_ALIGN, "WireTraits: alignof(MT) exceeds WIRE_ALIGN, the payload could not be referenced in place");
+
+    using View = const MT&;
+    static constexpr bool FIXED = true;
+
+    static std::size_t size(const MT &) { return sizeof(MT); }
+
+    static char* write(char *dest, const MT &value){
+        std::memcpy(dest, &value, sizeof(MT));
+        return dest + sizeof(MT);
+    }
+
+    static View view(const char *src) { return *std::launder(reinterpret_cast<const MT*>(src)); }
+    static const char* next(const char *src) { return src + sizeof(MT); }
+};
+
+/* 字符串：32位的长度和字符，读取时返回指向缓冲区的std::string_view */
+struct StringWire{
+    using View = std::string_view;
+    static constexpr bool FIXED = false;
+
+    static std::size_t size(std::string_view value) { return sizeof(std::uint32_t) + value.size(); }
+
+    static char* write(char *dest, std::string_view value){
+        const std::uint32_t length = static_cast<std::uint32_t>(value.size());
+        std::memcpy(dest, &length, sizeof(length));
+        std::memcpy(dest + sizeof(length), value.data(), value.size());
+        return dest + sizeof(length) + value.size();
+    }
+
+    static std::uint32_t length(const char *src){
+        std::uint32_t length;
+        std::memcpy(&length, src, sizeof(length));
+        return length;
+    }
+
+    /* src开始的一条消息是否完整地位于end之前 */
+    static bool fits(const char *src, const char *end){
+        const std::size_t left = static_cast<std::size_t>(end - src);
+        return left >= sizeof(std::uint32_t) && left - sizeof(std::uint32_t) >= length(src);
+    }
+
+    static View view(const char *src) { return View(src + sizeof(std::uint32_t), length(src)); }
+    static const char* next(const char *src) { return src + sizeof(std::uint32_t) + length(src); }
+};
+
+template<>
+struct WireTraits<std::string> : StringWire{};
+
+template<>
+struct WireTraits<std::string_view> : StringWire{};
+
+template<>
+struct WireTraits<const char*> : StringWire{};
+
+//===============FrameView===============
+/* 一帧中的消息，元素的类型为WireTraits<MT>::View */
+template<typename MT>
+class FrameView{
+    using Traits = WireTraits<MT>;
+
+public:
+    class iterator{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_cv_t<std::remove_reference_t<typename Traits::View>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = typename Traits::View;
+
+        iterator() = default;
+        explicit iterator(const char *pos) : m_pos(pos){}
+
+        reference operator*() const { return Traits::view(m_pos); }
+        iterator& operator++() { m_pos = Traits::next(m_pos); return *this; }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) { return lhs.m_pos == rhs.m_pos; }
+        friend bool operator!=(const iterator &lhs, const iterator &rhs) { return lhs.m_pos != rhs.m_pos; }
+
+    private:
+        const char *m_pos = nullptr;
+    };
+
+    FrameView() = default;
+    FrameView(const char *payload, std::uint32_t size, std::uint32_t count) : m_payload(payload), m_size(size), m_count(count){}
+
+    std::size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    iterator begin() const { return iterator(m_payload); }
+    iterator end() const { return iterator(m_payload + m_size); }
+
+    /* 只有定长的MT可以随机访问 */
+    template<typename T = MT, typename = std::enable_if_t<WireTraits<T>::FIXED>>
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(m_payload)); }
+
+    template<typename T = MT, typename = std::enable_if_t<WireTraits<T>::FIXED>>
+    const T& operator[](std::size_t i) const { return data()[i]; }
+
+private:
+    const char *m_payload = nullptr;
+    std::uint32_t m_size = 0;
+    std::uint32_t m_count = 0;
+};
+
+template<typename MT>
+struct DecodeResult{
+    FrameView<MT> frame;
+    std::size_t consumed;   //整帧的字节数，数据不足一帧时为0
+};
+
+//===============encode===============
+template<typename MT>
+std::size_t encodedSize(const Message<MT> *msgs, std::size_t count){
+    std::size_t payload = 0;
+    if constexpr (WireTraits<MT>::FIXED){
+        payload = count * sizeof(MT);
+    }else{
+        for(std::size_t i = 0; i < count; ++i) payload += WireTraits<MT>::size(msgs[i].m_msg);
+    }
+    return wirePadded(sizeof(WireHeader) + payload);
+}
+
+template<typename MT>
+std::size_t encodedSize(const Message<MT> &msg){
+    return encodedSize(&msg, 1);
+}
+
+/* 将count条消息编码为一帧写入buf，返回写入的字节数，缓冲区不足时不写入任何数据并返回0 */
+template<typename MT>
+std::size_t encodeBatch(char *buf, std::size_t capacity, const Message<MT> *msgs, std::size_t count){
+    using Traits = WireTraits<MT>;
+    const std::size_t total = encodedSize(msgs, count);
+    if(total > capacity) return 0;
+    const std::size_t payload = total - sizeof(WireHeader);
+    if(payload > UINT32_MAX || count > UINT32_MAX) throw std::length_error("encodeBatch: frame too large");
+
+    char *pos = buf + sizeof(WireHeader);
+    if constexpr (Traits::FIXED){
+        /* Message<MT>只有一个成员m_msg，因此Message<MT>数组的内存布局与MT数组相同 */
+        static_assert(sizeof(Message<MT>) == sizeof(MT) && std::is_trivially_copyable_v<Message<MT>>);
+        std::memcpy(pos, msgs, count * sizeof(MT));
+        pos += count * sizeof(MT);
+    }else{
+        for(std::size_t i = 0; i < count; ++i) pos = Traits::write(pos, msgs[i].m_msg);
+    }
+
+    const WireHeader header{static_cast<std::uint32_t>(pos - buf - sizeof(WireHeader)), static_cast<std::uint32_t>(count)};
+    std::memcpy(buf, &header, sizeof(header));
+    std::memset(pos, 0, buf + total - pos);
+    return total;
+}
+
+template<typename MT>
+std::size_t encode(char *buf, std::size_t capacity, const Message<MT> &msg){
+    return encodeBatch(buf, capacity, &msg, 1);
+}
+
+//===============decode===============
+/* 解析buf开头的一帧，返回的FrameView指向buf中的数据 */
+template<typename MT>
+DecodeResult<MT> decode(const char *buf, std::size_t n){
+    using Traits = WireTraits<MT>;
+    if(n < sizeof(WireHeader)) return {FrameView<MT>(), 0};
+    WireHeader header;
+    std::memcpy(&header, buf, sizeof(header));
+    const std::size_t total = wirePadded(sizeof(WireHeader) + header.size);
+    if(n < total) return {FrameView<MT>(), 0};
+
+    const char *payload = buf + sizeof(WireHeader);
+    if constexpr (Traits::FIXED){
+        if(header.size != static_cast<std::size_t>(header.count) * sizeof(MT)) throw std::invalid_argument("decode: payload size mismatch");
+        if(reinterpret_cast<std::uintptr_t>(payload) % alignof(MT) != 0) throw std::invalid_argument("decode: misaligned payload");
+    }else{
+        /* 变长的消息需要检查每条消息的长度都不会越过负载的末尾 */
+        const char *pos = payload;
+        const char *end = payload + header.size;
+        for(std::uint32_t i = 0; i < header.count; ++i){
+            if(!Traits::fits(pos, end)) throw std::invalid_argument("decode: truncated message");
+            pos = Traits::next(pos);
+        }
+        if(pos != end) throw std::invalid_argument("decode: payload size mismatch");
+    }
+    return {FrameView<MT>(payload, header.size, header.count), total};
+}
+
+#endif
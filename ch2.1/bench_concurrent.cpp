@@ -0,0 +1,97 @@
+/**
+ * 《并发容器的吞吐量测试》
+ * 分别使用1到N个线程对MpmcQueue和由std::mutex保护的Stack执行push/pop，统计每秒完成的操作数；SpscRing只允许一个生产者和一个消费者，因此单独以
+ * 两个线程进行测试。
+ * 用法：bench_concurrent.exe [最大线程数] [每个线程的操作次数]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "stack.hpp"
+#include "concurrent_stack.hpp"
+
+constexpr unsigned int CAPACITY = 1024;
+
+/* 用std::mutex包装的Stack，作为对照组 */
+template<typename T, unsigned int Size>
+class LockedStack{
+public:
+    bool push(const T &e){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stack.push(e);
+        return true;
+    }
+
+    bool pop(T &out){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        out = m_stack.top();
+        m_stack.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    Stack<T, Size> m_stack;
+};
+
+/* 每个线程交替执行push和pop，返回每秒完成的操作数 */
+template<typename Container>
+double run(unsigned int threads, std::size_t iterations){
+    Container cont;
+    std::vector<std::thread> workers;
+
+    auto begin = std::chrono::steady_clock::now();
+    for(unsigned int t = 0; t < threads; ++t){
+        workers.emplace_back([&cont, iterations, t]{
+            int value = 0;
+            for(std::size_t i = 0; i < iterations; ++i){
+                while(!cont.push(static_cast<int>(t))) std::this_thread::yield();
+                while(!cont.pop(value)) std::this_thread::yield();
+            }
+        });
+    }
+    for(auto &w : workers) w.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    return 2.0 * threads * iterations / elapsed.count();
+}
+
+double runSpsc(std::size_t iterations){
+    SpscRing<int, CAPACITY> ring;
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer([&ring, iterations]{
+        for(std::size_t i = 0; i < iterations; ++i){
+            while(!ring.push(static_cast<int>(i))) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&ring, iterations]{
+        int value = 0;
+        for(std::size_t i = 0; i < iterations; ++i){
+            while(!ring.pop(value)) std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    return 2.0 * iterations / elapsed.count();
+}
+
+int main(int argc, char *argv[]){
+    unsigned int hw = std::thread::hardware_concurrency();
+    unsigned int maxThreads = (argc > 1) ? std::atoi(argv[1]) : (hw > 4 ? hw : 4);
+    std::size_t iterations = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::cout << "threads\tMpmcQueue(ops/s)\tLockedStack(ops/s)" << std::endl;
+    for(unsigned int t = 1; t <= maxThreads; ++t){
+        double mpmc = run<MpmcQueue<int, CAPACITY>>(t, iterations);
+        double locked = run<LockedStack<int, CAPACITY>>(t, iterations);
+        std::cout << t << "\t" << mpmc << "\t" << locked << std::endl;
+    }
+
+    std::cout << "SpscRing 1P/1C(ops/s): " << runSpsc(iterations) << std::endl;
+}
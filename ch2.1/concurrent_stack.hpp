@@ -0,0 +1,189 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * 《固定容量的并发容器》
+ * stack.hpp中的Stack<T, Size>没有任何同步措施，当它被用作线程之间传递数据的缓冲区时，多个线程同时修改m_index会产生数据竞争。下方的两个模板保留了
+ * 非类型参数Size作为编译时确定的容量，并且同样不进行任何堆内存分配：
+ *   1.SpscRing<T, Size>：单生产者/单消费者环形缓冲区，push和pop都只包含有限步骤，不存在循环重试，是无等待(wait-free)的。
+ *   2.MpmcQueue<T, Size>：多生产者/多消费者有界队列，每个元素槽位带有一个序号，生产者和消费者通过CAS争夺位置，是无锁(lock-free)的。
+ * 与Stack不同，两者在容器满或空时不会静默地丢弃元素或返回T()，而是通过返回false告知调用者。
+ */
+
+/* 缓存行的大小，用于将被不同线程频繁写入的索引隔开，避免伪共享(false sharing) */
+constexpr std::size_t CACHE_LINE = 64;
+
+//===============SpscRing===============
+template<typename T, unsigned int Size>
+class SpscRing{
+    static_assert(Size > 0, "SpscRing: Size must be greater than 0");   //GNU模式接受长度为0的数组，但取模时会除以0
+
+public:
+    bool push(const T &e);   //仅允许生产者线程调用
+    bool push(T &&e);        //仅允许生产者线程调用
+    bool pop(T &out);        //仅允许消费者线程调用
+    bool empty() const;
+
+private:
+    template<typename U>
+    bool doPush(U &&e);
+
+    /**
+     * m_head和m_tail都是单调递增的计数，元素的实际位置为计数对Size取模的结果。每个索引只被一个线程写入，另一个线程只读取它，
+     * 并且双方各自缓存一份对方索引的旧值，只有在缓存的值表明容器已满/已空时才重新读取，以此减少缓存行在两个核心之间的来回传递。
+     */
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_head{};    //由消费者写入
+    std::size_t m_cachedTail{};                                //消费者缓存的m_tail
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_tail{};    //由生产者写入
+    std::size_t m_cachedHead{};                                //生产者缓存的m_head
+    alignas(CACHE_LINE) T m_elements[Size];
+};
+
+template<typename T, unsigned int Size>
+  template<typename U>
+bool SpscRing<T,Size>::doPush(U &&e){
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if(tail - m_cachedHead == Size){
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if(tail - m_cachedHead == Size) return false;
+    }
+
+    m_elements[tail % Size] = std::forward<U>(e);
+    m_tail.store(tail + 1, std::memory_order_release);  //release确保消费者看到新的m_tail时，元素也已经写入完成
+    return true;
+}
+
+template<typename T, unsigned int Size>
+bool SpscRing<T,Size>::push(const T &e){
+    return doPush(e);
+}
+
+template<typename T, unsigned int Size>
+bool SpscRing<T,Size>::push(T &&e){
+    return doPush(std::move(e));
+}
+
+template<typename T, unsigned int Size>
+bool SpscRing<T,Size>::pop(T &out){
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if(head == m_cachedTail){
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if(head == m_cachedTail) return false;
+    }
+
+    out = std::move(m_elements[head % Size]);
+    m_head.store(head + 1, std::memory_order_release);  //release确保生产者看到新的m_head时，元素已经被取走
+    return true;
+}
+
+template<typename T, unsigned int Size>
+bool SpscRing<T,Size>::empty() const{
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
+
+//===============MpmcQueue===============
+/**
+ * 每个槽位的序号seq描述了该槽位当前的状态：对于位置pos，当seq == pos时，槽位可供写入；当seq == pos + 1时，槽位中的元素可供读取；
+ * 元素被读取后，seq被设置为pos + Size，即下一轮同一槽位可供写入的位置。生产者和消费者都只在通过CAS获得某个位置后才访问对应的槽位。
+ */
+template<typename T, unsigned int Size>
+class MpmcQueue{
+    static_assert(Size > 0, "MpmcQueue: Size must be greater than 0");   //GNU模式接受长度为0的数组，但取模时会除以0
+
+public:
+    MpmcQueue();
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool push(const T &e);
+    bool push(T &&e);
+    bool pop(T &out);
+
+private:
+    template<typename U>
+    bool doPush(U &&e);
+
+    struct Cell{
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    alignas(CACHE_LINE) Cell m_cells[Size];
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_enqueuePos{};
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_dequeuePos{};
+    char m_padding[CACHE_LINE - sizeof(std::atomic<std::size_t>)];  //避免m_dequeuePos与紧随其后的其他对象共享缓存行
+};
+
+template<typename T, unsigned int Size>
+MpmcQueue<T,Size>::MpmcQueue(){
+    for(std::size_t i = 0; i < Size; ++i){
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, unsigned int Size>
+  template<typename U>
+bool MpmcQueue<T,Size>::doPush(U &&e){
+    Cell *cell;
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    for(;;){
+        cell = &m_cells[pos % Size];
+        const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if(diff == 0){
+            /* 槽位可写，尝试占据该位置，失败时pos会被更新为最新的m_enqueuePos */
+            if(m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }else if(diff < 0){
+            return false;   //该槽位上一轮的元素尚未被取走，队列已满
+        }else{
+            pos = m_enqueuePos.load(std::memory_order_relaxed);  //其他生产者已经占据了该位置
+        }
+    }
+
+    cell->value = std::forward<U>(e);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, unsigned int Size>
+bool MpmcQueue<T,Size>::push(const T &e){
+    return doPush(e);
+}
+
+template<typename T, unsigned int Size>
+bool MpmcQueue<T,Size>::push(T &&e){
+    return doPush(std::move(e));
+}
+
+template<typename T, unsigned int Size>
+bool MpmcQueue<T,Size>::pop(T &out){
+    Cell *cell;
+    std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+    for(;;){
+        cell = &m_cells[pos % Size];
+        const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if(diff == 0){
+            if(m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }else if(diff < 0){
+            return false;   //该槽位尚未写入元素，队列为空
+        }else{
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    out = std::move(cell->value);
+    cell->seq.store(pos + Size, std::memory_order_release);
+    return true;
+}
+
+#endif
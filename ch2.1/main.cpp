@@ -6,45 +6,12 @@
  */
 
 #include <iostream>
+#include <thread>
+#include "stack.hpp"
+#include "concurrent_stack.hpp"
 
 //========================================
-/**
- * 《非类型类模板参数》
- * 在本例中我们将演示如何对类模板使用非类型参数，我们将前面的Stack类改造为一个使用固定大小数组来保存元素的实现。就像定义旧版本的Stack一样，我们使用template
- * 声明了类型参数T，但不同之处在于我们还声明了一个非类型参数Size，非类型参数使用类型而非typename进行声明，该类型决定了非类型参数可以代表的值的类型，在本例
- * 中，我们使用了unsigned int声明了Size，因此在使用Stack模板时，我们可以为Size指定unsigned int类型的值。
- */
-template<typename T, unsigned int Size>
-class Stack{
-public:
-    void push(const T &e);
-    T      top();
-    void pop();
-
-private:
-    /* 可以看到，我们将Size用作了数组的长度，这样一来，数组的容量就可根据用户在使用Stack模板时为Size指定的值动态地调整 */
-    T m_elements[Size];
-    unsigned int m_index;
-};
-
-template<typename T, unsigned int Size>
-void Stack<T,Size>::push(const T &e){
-    if(m_index < Size){
-        m_elements[m_index] = e;
-        ++m_index;
-    }
-}
-
-template<typename T, unsigned int Size>
-T Stack<T,Size>::top(){
-    if(m_index - 1 < Size) return m_elements[m_index - 1];
-    return T();
-}
-
-template<typename T, unsigned int Size>
-void Stack<T,Size>::pop(){
-    if(m_index > 0) --m_index;
-}
+/* Stack的定义见stack.hpp */
 
 void func1(){
     Stack<int, 16> i16Stack;       //将Size指定为16，编译器将实例化一个数组容量为16的Stack版本
@@ -75,7 +42,43 @@ void func2(){
     std::cout << addValue<10>(e) << std::endl; //实例化一个为e增加10的addValue版本
 }
 
+//========================================
+/**
+ * 《固定容量的并发容器》
+ * concurrent_stack.hpp中的SpscRing和MpmcQueue同样以非类型参数Size指定容量，容器满或空时push和pop返回false，而不是丢弃元素。
+ */
+void func3(){
+    SpscRing<int, 4> ring;
+    int pushed = 0;
+    while(ring.push(pushed)) ++pushed;      //容量为4，第5次push返回false
+    int e = 0;
+    while(ring.pop(e)) std::cout << e << " ";
+    std::cout << "(pushed " << pushed << ", empty " << ring.empty() << ")" << std::endl;
+
+    /* 两个生产者线程同时写入，主线程读取全部元素 */
+    MpmcQueue<int, 8> queue;
+    auto produce = [&queue](int first){
+        for(int i = first; i < first + 100; ++i){
+            while(!queue.push(i)) std::this_thread::yield();
+        }
+    };
+    std::thread t1(produce, 0), t2(produce, 100);
+    long long sum = 0;
+    for(int received = 0; received < 200;){
+        if(queue.pop(e)){
+            sum += e;
+            ++received;
+        }else{
+            std::this_thread::yield();
+        }
+    }
+    t1.join();
+    t2.join();
+    std::cout << "sum " << sum << std::endl;   //0 + 1 + ... + 199 = 19900
+}
+
 int main(void){
     func1();
     func2();
+    func3();
 }
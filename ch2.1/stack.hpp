@@ -0,0 +1,42 @@
+#ifndef FIXED_STACK_HPP
+#define FIXED_STACK_HPP
+
+/**
+ * 《非类型类模板参数》
+ * 在本例中我们将演示如何对类模板使用非类型参数，我们将前面的Stack类改造为一个使用固定大小数组来保存元素的实现。就像定义旧版本的Stack一样，我们使用template
+ * 声明了类型参数T，但不同之处在于我们还声明了一个非类型参数Size，非类型参数使用类型而非typename进行声明，该类型决定了非类型参数可以代表的值的类型，在本例
+ * 中，我们使用了unsigned int声明了Size，因此在使用Stack模板时，我们可以为Size指定unsigned int类型的值。
+ */
+template<typename T, unsigned int Size>
+class Stack{
+public:
+    void push(const T &e);
+    T      top();
+    void pop();
+
+private:
+    /* 可以看到，我们将Size用作了数组的长度，这样一来，数组的容量就可根据用户在使用Stack模板时为Size指定的值动态地调整 */
+    T m_elements[Size];
+    unsigned int m_index{};  //值初始化为0，否则m_index将持有一个未定义的值
+};
+
+template<typename T, unsigned int Size>
+void Stack<T,Size>::push(const T &e){
+    if(m_index < Size){
+        m_elements[m_index] = e;
+        ++m_index;
+    }
+}
+
+template<typename T, unsigned int Size>
+T Stack<T,Size>::top(){
+    if(m_index - 1 < Size) return m_elements[m_index - 1];
+    return T();
+}
+
+template<typename T, unsigned int Size>
+void Stack<T,Size>::pop(){
+    if(m_index > 0) --m_index;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * 《std::unordered_map与StringDispatcher》
+ * 64个字符串键各自对应一个处理函数。请求序列由10^7个随机选取的键组成，其中约1/8是不存在的键。分别比较：
+ *   1.运行时的键：std::unordered_map<std::string, Fn>::find与StringDispatcher::operator()。
+ *   2.编译时的键：每次都以同一个std::string查找std::unordered_map，与StringDispatcher::handler<"get">。
+ * 用法：bench_dispatch.exe [请求数量]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "fixed_string.hpp"
+
+using Fn = long long (*)(long long);
+
+template<int I>
+long long handle(long long x) { return x * (I + 1) + I; }
+
+long long missing(long long x) { return -x; }
+
+template<int... I>
+constexpr auto makeDispatcher(std::integer_sequence<int, I...>){
+    return StringDispatcher<long long(long long),
+    "login", "logout", "register", "status", "ping", "pong", "get", "set",
+    "del", "incr", "decr", "append", "strlen", "exists", "expire", "ttl",
+    "keys", "scan", "rename", "type", "lpush", "rpush", "lpop", "rpop",
+    "llen", "lrange", "sadd", "srem", "smembers", "scard", "hset", "hget",
+    "hdel", "hkeys", "hvals", "hlen", "zadd", "zrem", "zrange", "zscore",
+    "zcard", "publish", "subscribe", "unsubscribe", "multi", "exec", "discard", "watch",
+    "unwatch", "auth", "select", "flushdb", "flushall", "save", "bgsave", "info",
+    "config", "monitor", "shutdown", "echo", "time", "quit", "getrange", "setrange"
+    >(missing, &handle<I>...);
+}
+
+constexpr auto dispatcher = makeDispatcher(std::make_integer_sequence<int, 64>{});
+using Dispatcher = decltype(dispatcher);
+
+template<int... I>
+std::unordered_map<std::string, Fn> makeMap(std::integer_sequence<int, I...>){
+    return {{std::string(Dispatcher::key(I)), &handle<I>}...};
+}
+
+int main(int argc, char *argv[]){
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    const std::unordered_map<std::string, Fn> table = makeMap(std::make_integer_sequence<int, 64>{});
+    const std::string misses[] = {"unknown", "logn", "getx", "zunionstore", "", "PING", "lset", "hincrby"};
+
+    std::mt19937 rng(42);
+    std::vector<std::string> requests;
+    requests.reserve(n);
+    for(std::size_t i = 0; i < n; ++i){
+        const unsigned r = rng() % 72;
+        requests.push_back(r < 64 ? std::string(Dispatcher::key(r)) : misses[r - 64]);
+    }
+
+    auto viaMap = [&table](const std::string &key, long long x){
+        auto it = table.find(key);
+        return it != table.end() ? it->second(x) : missing(x);
+    };
+
+    long long mapSum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < n; ++i) mapSum += viaMap(requests[i], static_cast<long long>(i));
+    std::chrono::duration<double, std::nano> mapNs = std::chrono::steady_clock::now() - begin;
+
+    long long dispatchSum = 0;
+    begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < n; ++i) dispatchSum += dispatcher(requests[i], static_cast<long long>(i));
+    std::chrono::duration<double, std::nano> dispatchNs = std::chrono::steady_clock::now() - begin;
+
+    const std::string get = "get";
+    long long mapFixedSum = 0;
+    begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < n; ++i) mapFixedSum += viaMap(get, static_cast<long long>(i));
+    std::chrono::duration<double, std::nano> mapFixedNs = std::chrono::steady_clock::now() - begin;
+
+    long long handlerSum = 0;
+    begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < n; ++i) handlerSum += dispatcher.handler<"get">(static_cast<long long>(i));
+    std::chrono::duration<double, std::nano> handlerNs = std::chrono::steady_clock::now() - begin;
+
+    std::cout << "key\tunordered_map(ns/op)\tStringDispatcher(ns/op)" << std::endl;
+    std::cout << "runtime\t" << mapNs.count() / n << "\t" << dispatchNs.count() / n
+              << "\t(check " << mapSum << " " << dispatchSum << ")" << std::endl;
+    std::cout << "\"get\"\t" << mapFixedNs.count() / n << "\t" << handlerNs.count() / n
+              << "\t(check " << mapFixedSum << " " << handlerSum << ")" << std::endl;
+}
@@ -0,0 +1,174 @@
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+/**
+ * 《可以用作非类型模板参数的字符串》
+ * main.cpp中的template<std::string Str>无法通过编译，因为std::string不能用作非类型模板参数。C++20放宽了这一限制：只要一个类是结构化类型
+ * (structural type)，即它的所有基类和非静态成员都是public且非mutable的，并且它们本身也是结构化类型，那么这个类的对象就可以用作非类型模板参数。
+ * FixedString<N>就是这样一个类型：
+ *   1.它以字符数组保存字符串，构造函数可以接受字符串字面量，并由类模板参数推断得到N，因此可以写出handler<"login">这样的模板实参。
+ *   2.字符串的FNV-1a哈希值在构造时计算并保存在成员hash中，由于模板实参必须是常量表达式，这个哈希值总是在编译时计算完成的。
+ * StringDispatcher<R(Args...), Keys...>在编译时为一组字符串Keys生成一张完美哈希表，每个键对应一个处理函数：
+ *   1.handler<"login">(args...)在编译时就确定了处理函数的下标，调用时既没有哈希计算也没有字符串比较，只是一次普通的函数调用。
+ *   2.operator()(key, args...)用于运行时才知道的键：它对key计算一次哈希，通过一次乘法和移位得到表中唯一可能的位置，再通过哈希值、长度和一次memcmp
+ *     确认两者相同。找不到对应的键时调用构造时指定的fallback。
+ */
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+constexpr std::uint64_t fnv1a(const char *data, std::size_t size){
+    std::uint64_t h = FNV_OFFSET;
+    for(std::size_t i = 0; i < size; ++i){
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+constexpr std::uint64_t fnv1a(std::string_view s) { return fnv1a(s.data(), s.size()); }
+
+template<std::size_t N>
+struct FixedString{
+    char text[N]{};
+    std::uint64_t hash = 0;
+
+    constexpr FixedString(const char (&str)[N]){
+        for(std::size_t i = 0; i < N; ++i) text[i] = str[i];
+        hash = fnv1a(text, N - 1);
+    }
+
+    static constexpr std::size_t size() { return N - 1; }     //不包括结尾的'\0'
+    constexpr std::string_view view() const { return std::string_view(text, N - 1); }
+};
+
+/* 编译时可用的字符串哈希值，可以直接用作switch语句的case标签 */
+template<FixedString Key>
+inline constexpr std::uint64_t key_hash = Key.hash;
+
+//===============StringDispatcher===============
+template<typename Signature, FixedString... Keys>
+class StringDispatcher;
+
+template<typename R, typename... Args, FixedString... Keys>
+class StringDispatcher<R(Args...), Keys...>{
+public:
+    using Handler = R (*)(Args...);
+    static constexpr std::size_t count = sizeof...(Keys);
+
+    /* handlers按照Keys的顺序排列 */
+    template<typename... H>
+    constexpr StringDispatcher(Handler fallback, H... handlers) : m_fallback(fallback), m_handlers{handlers...}{
+        static_assert(sizeof...(H) == count, "one handler is required for every key");
+    }
+
+    template<FixedString Key>
+    R handler(Args... args) const{
+        constexpr std::size_t i = indexOf(Key.view());
+        static_assert(i < count, "the key is not registered in this dispatcher");
+        return m_handlers[i](std::forward<Args>(args)...);
+    }
+
+    R operator() (std::string_view key, Args... args) const{
+        const std::uint64_t h = fnv1a(key);
+        const Slot &slot = TABLE.slots[(h * TABLE.multiplier) >> TABLE.shift];
+        if(slot.index < count && slot.hash == h && NAMES[slot.index].size() == key.size()
+           && std::memcmp(NAMES[slot.index].data(), key.data(), key.size()) == 0){
+            return m_handlers[slot.index](std::forward<Args>(args)...);
+        }
+        return m_fallback(std::forward<Args>(args)...);
+    }
+
+    static constexpr std::string_view key(std::size_t i) { return NAMES[i]; }
+
+    bool contains(std::string_view key) const{
+        const std::uint64_t h = fnv1a(key);
+        const Slot &slot = TABLE.slots[(h * TABLE.multiplier) >> TABLE.shift];
+        return slot.index < count && slot.hash == h && NAMES[slot.index] == key;
+    }
+
+private:
+    static_assert(count > 0, "StringDispatcher needs at least one key");
+
+    static constexpr std::string_view NAMES[count] = {Keys.view()...};
+    static constexpr std::uint64_t HASHES[count] = {Keys.hash...};
+
+    static constexpr std::size_t indexOf(std::string_view key){
+        for(std::size_t i = 0; i < count; ++i){
+            if(NAMES[i] == key) return i;
+        }
+        return count;
+    }
+
+    struct Slot{
+        std::uint64_t hash = 0;
+        std::size_t index = count;     //count表示空位
+    };
+
+    /* 第salt个候选乘数，取splitmix64的输出并保证其为奇数 */
+    static constexpr std::uint64_t candidate(std::uint64_t salt){
+        std::uint64_t z = salt * 0x9E3779B97F4A7C15ull + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return (z ^ (z >> 31)) | 1;
+    }
+
+    static constexpr unsigned MAX_SALT = 256;
+
+    /* 寻找一个乘数，使得每个键的哈希值乘以该乘数后的最高bits位互不相同；找不到时返回0 */
+    static constexpr std::uint64_t findMultiplier(unsigned bits){
+        for(std::uint64_t salt = 0; salt < MAX_SALT; ++salt){
+            const std::uint64_t m = candidate(salt);
+            bool collided = false;
+            for(std::size_t i = 0; i < count && !collided; ++i){
+                for(std::size_t j = 0; j < i && !collided; ++j){
+                    collided = ((HASHES[i] * m) >> (64 - bits)) == ((HASHES[j] * m) >> (64 - bits));
+                }
+            }
+            if(!collided) return m;
+        }
+        return 0;
+    }
+
+    /**
+     * 表的大小是2的幂，并且至少为键数量的两倍。如果在MAX_SALT个候选乘数中找不到没有冲突的乘数，就将表的大小加倍，因此运行时的查找只需要检查一个位置。
+     * 键之间不能存在相同的哈希值，否则任何乘数都会产生冲突，编译将失败。
+     */
+    static constexpr unsigned BITS = [](){
+        unsigned bits = 1;
+        while((std::size_t{1} << bits) < 2 * count) ++bits;
+        for(; bits < 24; ++bits){
+            if(findMultiplier(bits) != 0) return bits;
+        }
+        throw "no collision-free multiplier found for these keys";
+    }();
+
+    struct Table{
+        std::uint64_t multiplier = 0;
+        unsigned shift = 0;
+        std::array<Slot, std::size_t{1} << BITS> slots{};
+    };
+
+    static constexpr Table buildTable(){
+        Table t;
+        t.multiplier = findMultiplier(BITS);
+        t.shift = 64 - BITS;
+        for(std::size_t i = 0; i < count; ++i){
+            t.slots[(HASHES[i] * t.multiplier) >> t.shift] = Slot{HASHES[i], i};
+        }
+        return t;
+    }
+
+    static constexpr Table TABLE = buildTable();
+
+    Handler m_fallback;
+    Handler m_handlers[count];
+};
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * 《格式字符串print的吞吐量与内存分配》
+ * 以五个参数的调用比较main.cpp中的递归print、printf以及format.hpp中的print<"...">，输出写入标准输出，统计结果写入标准错误。
+ * 用法：bench_format.exe [调用次数] > /dev/null
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "format.hpp"
+
+//===============分配计数===============
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size){
+    ++g_allocations;
+    if(void *p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept                   { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+//===============递归print===============
+/* 与main.cpp中例1的print相同：参数包按值传递，每个参数递归一次，并通过std::endl输出 */
+void print(){
+}
+
+template<typename T, typename... Types>
+void print(const T &arg1, const Types... args){
+    std::cout << arg1 << std::endl;
+    print(args...);
+}
+
+template<typename F>
+void measure(const char *name, std::size_t calls, F f){
+    std::size_t allocBefore = g_allocations;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < calls; ++i) f(i);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout.flush();
+    std::fflush(stdout);
+
+    std::cerr << name << ": " << elapsed.count() / calls << " ns/call, "
+              << static_cast<double>(g_allocations - allocBefore) / calls << " allocs/call" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t calls = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::string user("a-user-name-longer-than-the-small-string-buffer");
+
+    /* 预热，使线程独有的缓冲区完成首次分配 */
+    ::print<"{}\n">(user);
+
+    measure("recursive print", calls, [&](std::size_t i){ print(i, " user=", user, " score=", 9.5); });
+    measure("printf", calls, [&](std::size_t i){ std::printf("%zu user=%s score=%g\n", i, user.c_str(), 9.5); });
+    measure("print<\"{} user={} score={}\\n\">", calls, [&](std::size_t i){ ::print<"{} user={} score={}\n">(i, user, 9.5); });
+}
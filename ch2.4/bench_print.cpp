@@ -0,0 +1,38 @@
+/**
+ * 《递归print与printLine的输出开销》
+ * 以10^6次五个参数的调用比较main.cpp中的递归print与print.hpp中的printLine，输出写入标准输出，耗时写入标准错误。
+ * 用法：bench_print.exe [调用次数] > /dev/null
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "print.hpp"
+
+/* 与main.cpp中例1的print相同：每个参数递归一次，并通过std::endl输出 */
+void print(){
+}
+
+template<typename T, typename... Types>
+void print(const T &arg1, const Types... args){
+    std::cout << arg1 << std::endl;
+    print(args...);
+}
+
+template<typename F>
+void measure(const char *name, std::size_t calls, F f){
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < calls; ++i) f(i);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cerr << name << ": " << elapsed.count() / calls << " ns/call" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t calls = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::string world("World");
+
+    measure("recursive print", calls, [&](std::size_t i){ print(i, 9.9, "Hello", world, 'c'); });
+    measure("printLine<'\\n'> (same output)", calls, [&](std::size_t i){ printLine<'\n'>(i, 9.9, "Hello", world, 'c'); });
+    measure("printLine<' '>", calls, [&](std::size_t i){ printLine<' '>(i, 9.9, "Hello", world, 'c'); });
+    measure("printLine<' ', '\\n', false>", calls, [&](std::size_t i){ printLine<' ', '\n', false>(i, 9.9, "Hello", world, 'c'); });
+}
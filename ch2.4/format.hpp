@@ -0,0 +1,115 @@
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "print.hpp"
+
+/**
+ * 《编译时解析的格式字符串》
+ * C++20允许字面量类类型(literal class type)的对象作为非类型模板参数，只要它的所有成员都是public且非mutable的。FormatString<N>满足这个要求，
+ * 并且它的构造函数可以接受字符串字面量，因此我们可以写出print<"x = {}, y = {}\n">(x, y)这样的调用：格式字符串成为了模板参数的一部分，
+ * 对它的解析完全在编译时完成。
+ *   1.“{}”是参数的占位符，“{{”和“}}”分别输出“{”和“}”；其他单独出现的花括号是错误的格式，会导致编译失败。
+ *   2.占位符的数量必须与参数的数量一致，否则static_assert会在编译时报告错误。
+ *   3.解析结果是一个constexpr数组，print借助std::index_sequence将数组中的每一段展开为一条输出语句，运行时不存在任何对格式字符串的解析。
+ *   4.参数以const引用接收，输出写入print.hpp中线程独有的缓冲区，最后只调用一次std::cout.write，并且不刷新输出流，需要换行时在格式字符串中加入“\n”。
+ *     与printLine相同，每次调用开始时流的格式和错误状态都会被重置，不受之前调用的影响。
+ */
+template<std::size_t N>
+struct FormatString{
+    char text[N]{};
+
+    constexpr FormatString(const char (&str)[N]){
+        for(std::size_t i = 0; i < N; ++i) text[i] = str[i];
+    }
+
+    constexpr std::size_t length() const { return N - 1; }   //不包括结尾的'\0'
+};
+
+/* 格式字符串被切分为若干段，每一段要么是一段原样输出的文本，要么是一个参数 */
+struct FormatPiece{
+    bool isArg = false;
+    std::size_t pos = 0;     //文本在格式字符串中的起始位置
+    std::size_t len = 0;     //文本长度
+    std::size_t arg = 0;     //参数的序号
+};
+
+/* 当out为nullptr时只统计段的数量。遇到不成对的花括号时抛出异常，由于该函数在常量表达式中求值，抛出异常将导致编译错误 */
+template<std::size_t N>
+constexpr std::size_t parseFormat(const FormatString<N> &fmt, FormatPiece *out){
+    std::size_t count = 0, args = 0, start = 0;
+    auto text = [&](std::size_t end){
+        if(end > start){
+            if(out) out[count] = FormatPiece{false, start, end - start, 0};
+            ++count;
+        }
+    };
+
+    for(std::size_t i = 0; i < fmt.length(); ++i){
+        const char c = fmt.text[i];
+        if(c != '{' && c != '}') continue;
+
+        const bool paired = i + 1 < fmt.length() && fmt.text[i + 1] == c;
+        if(paired){
+            text(i + 1);     //保留两个花括号中的第一个
+            start = i + 2;
+            ++i;
+        }else if(c == '{' && i + 1 < fmt.length() && fmt.text[i + 1] == '}'){
+            text(i);
+            if(out) out[count] = FormatPiece{true, 0, 0, args};
+            ++count;
+            ++args;
+            start = i + 2;
+            ++i;
+        }else{
+            throw "unmatched brace in format string";
+        }
+    }
+    text(fmt.length());
+
+    return count;
+}
+
+template<FormatString Fmt>
+constexpr auto formatPieces(){
+    std::array<FormatPiece, parseFormat(Fmt, nullptr)> pieces{};
+    parseFormat(Fmt, pieces.data());
+    return pieces;
+}
+
+template<FormatString Fmt>
+constexpr std::size_t placeholderCount(){
+    std::size_t n = 0;
+    for(const FormatPiece &p : formatPieces<Fmt>()) n += p.isArg ? 1 : 0;
+    return n;
+}
+
+template<FormatString Fmt, std::size_t I, typename Tuple>
+void emitPiece(std::ostream &os, const Tuple &args){
+    constexpr FormatPiece piece = formatPieces<Fmt>()[I];
+    if constexpr (piece.isArg){
+        os << std::get<piece.arg>(args);
+    }else{
+        os.rdbuf()->sputn(Fmt.text + piece.pos, static_cast<std::streamsize>(piece.len));
+    }
+}
+
+template<FormatString Fmt, typename... Types>
+void print(const Types&... args){
+    static_assert(placeholderCount<Fmt>() == sizeof...(Types), "the number of {} placeholders must match the number of arguments");
+
+    LineWriter &writer = lineWriter();
+    writer.start();
+
+    const auto refs = std::forward_as_tuple(args...);
+    [&]<std::size_t... I>(std::index_sequence<I...>){
+        (emitPiece<Fmt, I>(writer.os, refs), ...);
+    }(std::make_index_sequence<formatPieces<Fmt>().size()>{});
+
+    std::cout.write(writer.buf.data(), static_cast<std::streamsize>(writer.buf.size()));
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef PRINT_HPP
+#define PRINT_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+/**
+ * 《基于折叠表达式的缓冲输出》
+ * main.cpp中的print每处理一个参数就递归调用一次，并且每个参数都通过std::endl输出，而std::endl除了换行之外还会刷新一次输出流。当print被用作日志输出时，
+ * 刷新操作会成为主要开销。printLine使用C++17的折叠表达式在一次调用中展开整个参数包，所有参数先被格式化到当前线程独有的缓冲区中，最后只调用一次
+ * std::cout.write，并且至多刷新一次。
+ *   1.分隔符Sep和结束符End是非类型模板参数，在编译时确定；将Sep指定为'\0'表示参数之间不输出分隔符。
+ *   2.Flush决定写入后是否刷新std::cout，默认为true，以保持与std::endl相同的可见性；日志等场景可以将其指定为false，由流自身的缓冲策略决定何时刷新。
+ *   3.参数包以const引用接收，不会拷贝任何参数。
+ * printLine<'\n'>(args...)的输出与main.cpp中的print(args...)相同。
+ */
+
+/* 将所有输出追加到一段可复用的内存中，缓冲区只在第一次使用或者容量不足时分配内存 */
+class LineBuffer : public std::streambuf{
+public:
+    LineBuffer() : m_buf(256, '\0') { reset(); }
+
+    const char* data() const { return pbase(); }
+    std::size_t size() const    { return static_cast<std::size_t>(pptr() - pbase()); }
+    void reset()                     { setp(&m_buf[0], &m_buf[0] + m_buf.size()); }
+
+protected:
+    int_type overflow(int_type ch) override{
+        const std::size_t used = size();
+        m_buf.resize(m_buf.size() * 2);
+        reset();
+        pbump(static_cast<int>(used));
+
+        if(!traits_type::eq_int_type(ch, traits_type::eof())){
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+private:
+    std::string m_buf;
+};
+
+/* 每个线程拥有自己的缓冲区和格式化用的ostream，因此多个线程同时调用printLine时无需加锁，每一行也不会与其他线程的输出交错 */
+struct LineWriter{
+    LineBuffer buf;
+    std::ostream os{&buf};
+
+    /* os在多次调用之间复用，参数中的std::hex等操纵符和输出失败时设置的badbit都会保留下来，因此每次调用开始时清空缓冲区，清除错误状态，
+     * 并将格式恢复为新建的流的默认值 */
+    std::ostream& start(){
+        buf.reset();
+        os.clear();
+        os.flags(std::ios_base::skipws | std::ios_base::dec);
+        os.precision(6);
+        os.width(0);
+        os.fill(' ');
+        return os;
+    }
+};
+
+inline LineWriter& lineWriter(){
+    thread_local LineWriter writer;
+    return writer;
+}
+
+template<char Sep = ' ', char End = '\n', bool Flush = true, typename... Types>
+void printLine(const Types&... args){
+    LineWriter &writer = lineWriter();
+    writer.start();
+
+    bool first = true;
+    auto put = [&writer, &first](const auto &arg){
+        if constexpr (Sep != '\0'){
+            if(!first) writer.os << Sep;
+        }
+        first = false;
+        writer.os << arg;
+    };
+
+    /* 一元右折叠，以逗号操作符展开为(put(arg1), (put(arg2), put(arg3)))，按照参数的顺序依次格式化，整个过程没有递归调用 */
+    (put(args), ...);
+    if constexpr (End != '\0'){
+        writer.os << End;
+    }
+
+    std::cout.write(writer.buf.data(), static_cast<std::streamsize>(writer.buf.size()));
+    if constexpr (Flush){
+        std::cout.flush();
+    }
+}
+
+#endif
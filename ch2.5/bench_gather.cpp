@@ -0,0 +1,53 @@
+/**
+ * 《从行缓冲区中提取固定列》
+ * 每行包含32个int，分别以连续、等间距和不规则的索引提取4、8、16个字段，比较gatherEach(逐个下标)与gather的吞吐量。为了避免占用过多内存，
+ * 行缓冲区只包含ROWS行，测试时循环遍历该缓冲区，直到累计处理的行数达到总行数。
+ * 用法：bench_gather.exe [总行数]
+ */
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "gather.hpp"
+
+constexpr std::size_t WIDTH = 32;
+constexpr std::size_t ROWS = 100000;
+using Row = std::array<int, WIDTH>;
+
+template<typename F>
+void measure(const char *name, const std::vector<Row> &rows, std::size_t total, F f){
+    long long sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t done = 0; done < total; done += rows.size()){
+        for(const Row &row : rows){
+            for(int v : f(row)) sink += v;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << name << "\t" << total / elapsed.count() / 1e6 << " M rows/s\t(sink " << sink << ")" << std::endl;
+}
+
+/* 对同一组索引分别测试gatherEach和gather */
+#define BENCH_PATTERN(label, ...)                                                                                  \
+    measure(label " each  ", rows, total, [](const Row &r){ return gatherEach<__VA_ARGS__>(r); });             \
+    measure(label " gather", rows, total, [](const Row &r){ return gather<__VA_ARGS__>(r); });
+
+int main(int argc, char *argv[]){
+    std::size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::vector<Row> rows(ROWS);
+    for(std::size_t r = 0; r < ROWS; ++r){
+        for(std::size_t c = 0; c < WIDTH; ++c) rows[r][c] = static_cast<int>(r * WIDTH + c);
+    }
+
+    BENCH_PATTERN("4  contiguous", 4, 5, 6, 7)
+    BENCH_PATTERN("4  strided   ", 0, 4, 8, 12)
+    BENCH_PATTERN("4  irregular ", 1, 3, 8, 20)
+    BENCH_PATTERN("8  contiguous", 8, 9, 10, 11, 12, 13, 14, 15)
+    BENCH_PATTERN("8  strided   ", 0, 4, 8, 12, 16, 20, 24, 28)
+    BENCH_PATTERN("8  irregular ", 0, 1, 5, 6, 11, 17, 23, 30)
+    BENCH_PATTERN("16 contiguous", 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+    BENCH_PATTERN("16 strided   ", 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30)
+    BENCH_PATTERN("16 irregular ", 0, 1, 3, 4, 7, 9, 10, 12, 15, 18, 19, 22, 25, 27, 28, 31)
+}
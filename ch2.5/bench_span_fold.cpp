@@ -0,0 +1,55 @@
+/**
+ * 《span版本add/addScalar的吞吐量》
+ * 对int、float、double分别测试普通循环、SSE2、AVX2以及自动分派版本在不同长度数组上的吞吐量(每秒处理的元素数量)。
+ * 用法：bench_span_fold.exe [最大长度]，默认测试16、256、4096、65536、2^20、2^24、10^8
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <vector>
+#include "span_fold.hpp"
+
+template<typename F>
+double melemPerSec(std::size_t n, F f){
+    const std::size_t repeat = (n >= 100000000) ? 3 : 300000000 / n;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < repeat; ++i) f();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(n) * repeat / elapsed.count();
+}
+
+template<typename T>
+void run(const char *type, std::size_t n){
+    std::vector<T> data(n, T(1));
+    volatile T sink{};
+
+    std::cout << type << "\t" << n;
+    for(SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}){
+        if(static_cast<int>(level) > static_cast<int>(simdLevel())){
+            std::cout << "\t-\t-";
+            continue;
+        }
+        SumKernel<T> sum = sumKernel<T>(level);
+        AddScalarKernel<T> addK = addScalarKernel<T>(level);
+        std::cout << "\t" << melemPerSec(n, [&]{ sink = sum(data.data(), n); })
+                  << "\t" << melemPerSec(n, [&]{ addK(data.data(), n, T(1)); });
+    }
+    std::cout << "\t" << melemPerSec(n, [&]{ sink = add(data); }) << std::endl;
+    (void)sink;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t maxSize = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    const std::size_t sizes[] = {16, 256, 4096, 65536, 1 << 20, 1 << 24, 100000000};
+    const char *levels[] = {"scalar", "sse2", "avx2"};
+
+    std::cout << "detected: " << levels[static_cast<int>(simdLevel())] << std::endl;
+    std::cout << "type\tN\tscalar add\tscalar addScalar\tsse2 add\tsse2 addScalar\tavx2 add\tavx2 addScalar\tadd(span)  (M elements/s)" << std::endl;
+    for(std::size_t n : sizes){
+        if(n > maxSize) break;
+        run<int>("int", n);
+        run<float>("float", n);
+        run<double>("double", n);
+    }
+}
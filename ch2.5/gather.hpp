@@ -0,0 +1,112 @@
+#ifndef GATHER_HPP
+#define GATHER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《基于可变索引的gather/scatter》
+ * main.cpp中的printIndic<Idx...>(container)将可变索引展开为“container[Idx]...”，即每个索引对应一个单独的下标表达式。由于索引是非类型模板参数，它们的值
+ * 在编译时就已确定，因此我们可以在编译时分析这组索引的分布，并为不同的分布选择不同的实现：
+ *   1.连续的索引(例如<4, 5, 6, 7>)：如果容器的元素连续存放并且可以平凡拷贝，那么整组元素可以通过一次memcpy读取。
+ *   2.等间距的索引(例如<0, 4, 8, 12>)：从编译时确定的起点出发，按照编译时确定的步长展开为一组基于同一指针的访问，编译器可以将其合并为向量指令。
+ *   3.其他索引：回落到“container[Idx]...”的形式。
+ * gather返回一个std::array，其元素顺序与Idx的顺序相同；scatter则执行相反的操作，将std::array中的元素写回容器中对应的位置。
+ */
+template<std::size_t... Idx>
+struct IndexPattern{
+    static constexpr std::size_t count = sizeof...(Idx);
+    static constexpr std::array<std::size_t, count> indices{Idx...};
+
+    static constexpr std::size_t first(){
+        if constexpr (count == 0) return 0;
+        else return indices[0];
+    }
+
+    /* 索引按照相同的正步长递增时返回该步长，否则返回0；少于两个索引时视为步长为1 */
+    static constexpr std::size_t stride(){
+        if constexpr (count < 2) return 1;
+        else{
+            if(indices[1] <= indices[0]) return 0;
+            const std::size_t step = indices[1] - indices[0];
+            for(std::size_t i = 2; i < count; ++i){
+                if(indices[i] <= indices[i - 1] || indices[i] - indices[i - 1] != step) return 0;
+            }
+            return step;
+        }
+    }
+
+    static constexpr bool contiguous = stride() == 1;
+    static constexpr bool strided = stride() > 1;
+};
+
+template<typename C>
+using ElementOf = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<C&>()[0])>>;
+
+/* 检测容器是否可以通过std::data获取指向连续元素的指针，原始数组、std::array、std::vector、std::span等均满足该条件 */
+template<typename C, typename = void>
+constexpr bool hasData = false;
+
+template<typename C>
+constexpr bool hasData<C, std::void_t<decltype(std::data(std::declval<C&>()))>> = true;
+
+/* 不分析索引分布，直接展开为每个索引一个下标表达式，与printIndic的做法相同 */
+template<std::size_t... Idx, typename C>
+std::array<ElementOf<const C>, sizeof...(Idx)> gatherEach(const C &container){
+    return {container[Idx]...};
+}
+
+template<std::size_t... Idx, typename C>
+std::array<ElementOf<const C>, sizeof...(Idx)> gather(const C &container){
+    using P = IndexPattern<Idx...>;
+    using T = ElementOf<const C>;
+
+    if constexpr (hasData<const C>){
+        std::array<T, P::count> out;
+        const T *src = std::data(container) + P::first();
+
+        if constexpr (P::contiguous && std::is_trivially_copyable_v<T>){
+            std::memcpy(out.data(), src, sizeof(T) * P::count);
+            return out;
+        }else if constexpr (P::contiguous || P::strided){
+            /* 展开为out = {src[0], src[stride], src[2 * stride], ...}，所有偏移量都是编译时常量 */
+            [&]<std::size_t... I>(std::index_sequence<I...>){
+                ((out[I] = src[I * P::stride()]), ...);
+            }(std::make_index_sequence<P::count>{});
+            return out;
+        }else{
+            return gatherEach<Idx...>(container);
+        }
+    }else{
+        return gatherEach<Idx...>(container);
+    }
+}
+
+template<std::size_t... Idx, typename C, typename T>
+void scatter(C &container, const std::array<T, sizeof...(Idx)> &values){
+    using P = IndexPattern<Idx...>;
+
+    if constexpr (hasData<C> && std::is_same_v<ElementOf<C>, T>){
+        T *dest = std::data(container) + P::first();
+
+        if constexpr (P::contiguous && std::is_trivially_copyable_v<T>){
+            std::memcpy(dest, values.data(), sizeof(T) * P::count);
+            return;
+        }else if constexpr (P::contiguous || P::strided){
+            [&]<std::size_t... I>(std::index_sequence<I...>){
+                ((dest[I * P::stride()] = values[I]), ...);
+            }(std::make_index_sequence<P::count>{});
+            return;
+        }
+    }
+
+    [&]<std::size_t... I>(std::index_sequence<I...>){
+        ((container[Idx] = values[I]), ...);
+    }(std::make_index_sequence<sizeof...(Idx)>{});
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef SPAN_FOLD_HPP
+#define SPAN_FOLD_HPP
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SPAN_FOLD_X86 1
+#endif
+
+/**
+ * 《运行时数组上的add/addOne》
+ * main.cpp中的add(args...)和addOne(args...)作用于编译时确定的参数包，展开后的表达式数量等于参数的数量，适用于少量参数。当同样的运算作用于运行时才能
+ * 确定长度的大数组时，我们需要的是循环，并且希望每次循环处理尽可能多的元素：
+ *   1.add(std::span<const T>)：对所有元素求和，对应add(args...)的“args + ...”。
+ *   2.addScalar(std::span<T>, k)：为每个元素加上k，对应addOne(args...)的“(args + 1)...”，结果直接写回原数组。
+ * 两者都可以直接接受std::vector、std::array、原始数组等任意连续范围。
+ * 两者都为int、float、double提供了SSE2和AVX2版本的实现，在第一次调用时根据CPU支持的指令集选择其中一个，此后的调用直接使用选中的版本；非x86平台以及
+ * 其他元素类型使用普通循环。需要注意，SIMD版本的求和改变了浮点数的相加顺序，因此float和double的结果可能与逐个相加的结果存在舍入误差上的差异。
+ */
+
+enum class SimdLevel{ Scalar, SSE2, AVX2 };
+
+inline SimdLevel detectSimdLevel(){
+#ifdef SPAN_FOLD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if(__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline SimdLevel simdLevel(){
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+template<typename T>
+using SumKernel = T (*)(const T*, std::size_t);
+
+template<typename T>
+using AddScalarKernel = void (*)(T*, std::size_t, T);
+
+//===============普通循环===============
+template<typename T>
+T sumScalar(const T *data, std::size_t n){
+    T sum{};
+    for(std::size_t i = 0; i < n; ++i) sum += data[i];
+    return sum;
+}
+
+template<typename T>
+void addScalarScalar(T *data, std::size_t n, T k){
+    for(std::size_t i = 0; i < n; ++i) data[i] += k;
+}
+
+#ifdef SPAN_FOLD_X86
+//===============SIMD===============
+/**
+ * 每种指令集和元素类型的组合对应一个Ops，它们以相同的名字提供加载、存储、相加、广播和水平求和操作，因此求和与加常数的循环只需要各写一次。
+ * Ops及使用它们的函数都以target属性编译，只有在CPU支持相应的指令集时才会被调用。
+ */
+template<typename T> struct Sse2Ops;
+template<typename T> struct Avx2Ops;
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+template<>
+struct Sse2Ops<int>{
+    using Vec = __m128i;
+    static constexpr std::size_t lanes = 4;
+    SSE2_TARGET static Vec zero()                      { return _mm_setzero_si128(); }
+    SSE2_TARGET static Vec set1(int k)                 { return _mm_set1_epi32(k); }
+    SSE2_TARGET static Vec load(const int *p)          { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE2_TARGET static void store(int *p, Vec v)       { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    SSE2_TARGET static Vec add(Vec a, Vec b)           { return _mm_add_epi32(a, b); }
+    SSE2_TARGET static int hsum(Vec v){
+        alignas(16) int lane[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane), v);
+        return lane[0] + lane[1] + lane[2] + lane[3];
+    }
+};
+
+template<>
+struct Sse2Ops<float>{
+    using Vec = __m128;
+    static constexpr std::size_t lanes = 4;
+    SSE2_TARGET static Vec zero()                      { return _mm_setzero_ps(); }
+    SSE2_TARGET static Vec set1(float k)               { return _mm_set1_ps(k); }
+    SSE2_TARGET static Vec load(const float *p)        { return _mm_loadu_ps(p); }
+    SSE2_TARGET static void store(float *p, Vec v)     { _mm_storeu_ps(p, v); }
+    SSE2_TARGET static Vec add(Vec a, Vec b)           { return _mm_add_ps(a, b); }
+    SSE2_TARGET static float hsum(Vec v){
+        alignas(16) float lane[4];
+        _mm_store_ps(lane, v);
+        return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+    }
+};
+
+template<>
+struct Sse2Ops<double>{
+    using Vec = __m128d;
+    static constexpr std::size_t lanes = 2;
+    SSE2_TARGET static Vec zero()                      { return _mm_setzero_pd(); }
+    SSE2_TARGET static Vec set1(double k)              { return _mm_set1_pd(k); }
+    SSE2_TARGET static Vec load(const double *p)       { return _mm_loadu_pd(p); }
+    SSE2_TARGET static void store(double *p, Vec v)    { _mm_storeu_pd(p, v); }
+    SSE2_TARGET static Vec add(Vec a, Vec b)           { return _mm_add_pd(a, b); }
+    SSE2_TARGET static double hsum(Vec v){
+        alignas(16) double lane[2];
+        _mm_store_pd(lane, v);
+        return lane[0] + lane[1];
+    }
+};
+
+template<>
+struct Avx2Ops<int>{
+    using Vec = __m256i;
+    static constexpr std::size_t lanes = 8;
+    AVX2_TARGET static Vec zero()                      { return _mm256_setzero_si256(); }
+    AVX2_TARGET static Vec set1(int k)                 { return _mm256_set1_epi32(k); }
+    AVX2_TARGET static Vec load(const int *p)          { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2_TARGET static void store(int *p, Vec v)       { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2_TARGET static Vec add(Vec a, Vec b)           { return _mm256_add_epi32(a, b); }
+    AVX2_TARGET static int hsum(Vec v){
+        alignas(32) int lane[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane), v);
+        return (lane[0] + lane[1] + lane[2] + lane[3]) + (lane[4] + lane[5] + lane[6] + lane[7]);
+    }
+};
+
+template<>
+struct Avx2Ops<float>{
+    using Vec = __m256;
+    static constexpr std::size_t lanes = 8;
+    AVX2_TARGET static Vec zero()                      { return _mm256_setzero_ps(); }
+    AVX2_TARGET static Vec set1(float k)               { return _mm256_set1_ps(k); }
+    AVX2_TARGET static Vec load(const float *p)        { return _mm256_loadu_ps(p); }
+    AVX2_TARGET static void store(float *p, Vec v)     { _mm256_storeu_ps(p, v); }
+    AVX2_TARGET static Vec add(Vec a, Vec b)           { return _mm256_add_ps(a, b); }
+    AVX2_TARGET static float hsum(Vec v){
+        alignas(32) float lane[8];
+        _mm256_store_ps(lane, v);
+        return ((lane[0] + lane[1]) + (lane[2] + lane[3])) + ((lane[4] + lane[5]) + (lane[6] + lane[7]));
+    }
+};
+
+template<>
+struct Avx2Ops<double>{
+    using Vec = __m256d;
+    static constexpr std::size_t lanes = 4;
+    AVX2_TARGET static Vec zero()                      { return _mm256_setzero_pd(); }
+    AVX2_TARGET static Vec set1(double k)              { return _mm256_set1_pd(k); }
+    AVX2_TARGET static Vec load(const double *p)       { return _mm256_loadu_pd(p); }
+    AVX2_TARGET static void store(double *p, Vec v)    { _mm256_storeu_pd(p, v); }
+    AVX2_TARGET static Vec add(Vec a, Vec b)           { return _mm256_add_pd(a, b); }
+    AVX2_TARGET static double hsum(Vec v){
+        alignas(32) double lane[4];
+        _mm256_store_pd(lane, v);
+        return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+    }
+};
+
+/* 使用4个相互独立的累加器，使相邻的加法指令之间没有数据依赖，从而可以流水线执行 */
+#define SPAN_FOLD_SUM_BODY(Ops)                                                         \
+    using V = typename Ops::Vec;                                                        \
+    constexpr std::size_t L = Ops::lanes;                                               \
+    V acc0 = Ops::zero(), acc1 = Ops::zero(), acc2 = Ops::zero(), acc3 = Ops::zero();   \
+    std::size_t i = 0;                                                                  \
+    for(; i + 4 * L <= n; i += 4 * L){                                                  \
+        acc0 = Ops::add(acc0, Ops::load(data + i));                                     \
+        acc1 = Ops::add(acc1, Ops::load(data + i + L));                                 \
+        acc2 = Ops::add(acc2, Ops::load(data + i + 2 * L));                             \
+        acc3 = Ops::add(acc3, Ops::load(data + i + 3 * L));                             \
+    }                                                                                   \
+    for(; i + L <= n; i += L) acc0 = Ops::add(acc0, Ops::load(data + i));               \
+    T sum = Ops::hsum(Ops::add(Ops::add(acc0, acc1), Ops::add(acc2, acc3)));           \
+    for(; i < n; ++i) sum += data[i];                                                   \
+    return sum;
+
+#define SPAN_FOLD_ADD_SCALAR_BODY(Ops)                                                  \
+    constexpr std::size_t L = Ops::lanes;                                               \
+    const typename Ops::Vec kv = Ops::set1(k);                                          \
+    std::size_t i = 0;                                                                  \
+    for(; i + L <= n; i += L) Ops::store(data + i, Ops::add(Ops::load(data + i), kv));  \
+    for(; i < n; ++i) data[i] += k;
+
+template<typename T>
+SSE2_TARGET T sumSse2(const T *data, std::size_t n){ SPAN_FOLD_SUM_BODY(Sse2Ops<T>) }
+
+template<typename T>
+AVX2_TARGET T sumAvx2(const T *data, std::size_t n){ SPAN_FOLD_SUM_BODY(Avx2Ops<T>) }
+
+template<typename T>
+SSE2_TARGET void addScalarSse2(T *data, std::size_t n, T k){ SPAN_FOLD_ADD_SCALAR_BODY(Sse2Ops<T>) }
+
+template<typename T>
+AVX2_TARGET void addScalarAvx2(T *data, std::size_t n, T k){ SPAN_FOLD_ADD_SCALAR_BODY(Avx2Ops<T>) }
+
+#undef SPAN_FOLD_SUM_BODY
+#undef SPAN_FOLD_ADD_SCALAR_BODY
+#undef SSE2_TARGET
+#undef AVX2_TARGET
+#endif
+
+//===============分派===============
+template<typename T>
+constexpr bool hasSimdKernel = std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/* 返回指定指令集对应的实现，如果当前平台或元素类型没有该实现，则返回普通循环的版本 */
+template<typename T>
+SumKernel<T> sumKernel(SimdLevel level){
+#ifdef SPAN_FOLD_X86
+    if constexpr (hasSimdKernel<T>){
+        if(level == SimdLevel::AVX2) return &sumAvx2<T>;
+        if(level == SimdLevel::SSE2) return &sumSse2<T>;
+    }
+#endif
+    (void)level;
+    return &sumScalar<T>;
+}
+
+template<typename T>
+AddScalarKernel<T> addScalarKernel(SimdLevel level){
+#ifdef SPAN_FOLD_X86
+    if constexpr (hasSimdKernel<T>){
+        if(level == SimdLevel::AVX2) return &addScalarAvx2<T>;
+        if(level == SimdLevel::SSE2) return &addScalarSse2<T>;
+    }
+#endif
+    (void)level;
+    return &addScalarScalar<T>;
+}
+
+template<typename T>
+T add(std::span<const T> data){
+    static const SumKernel<T> kernel = sumKernel<T>(simdLevel());
+    return kernel(data.data(), data.size());
+}
+
+template<typename T>
+void addScalar(std::span<T> data, T k){
+    static const AddScalarKernel<T> kernel = addScalarKernel<T>(simdLevel());
+    kernel(data.data(), data.size(), k);
+}
+
+/* T无法从std::vector<int>、原始数组等参数推断，以下重载接受任意连续范围，并将其转换为相应的std::span */
+template<std::ranges::contiguous_range R>
+auto add(const R &data){
+    return add(std::span<const std::ranges::range_value_t<R>>(data));
+}
+
+template<std::ranges::contiguous_range R>
+    requires (!std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>>)
+void addScalar(R &&data, std::ranges::range_value_t<R> k){
+    addScalar(std::span<std::ranges::range_value_t<R>>(data), k);
+}
+
+#endif
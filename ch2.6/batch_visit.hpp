@@ -0,0 +1,74 @@
+#ifndef BATCH_VISIT_HPP
+#define BATCH_VISIT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * 《以Overloader分批访问std::variant》
+ * Overloader将多个基类的operator()合并为一组重载，这正好可以作为std::visit的访问者：std::visit(ops, v)会根据v当前保存的类型调用ops中相应的重载。
+ * 但std::visit对每个元素都要通过一张跳转表进行一次间接调用，当需要访问的是一长串类型混杂的variant时，这些间接调用既无法内联，也难以被CPU正确预测。
+ * BatchVisitor<Ts...>换了一种方式，它将序列划分为若干个长度为Chunk的分块，对每个分块：
+ *   1.第一遍只根据v.index()将元素在分块中的位置放入对应的桶中，这一步不涉及任何对ops的调用，也没有依赖于元素类型的分支。
+ *   2.第二遍按照类型逐个处理每个桶，由于同一个桶中的元素类型相同，对ops的调用在编译时就已确定，可以被内联，并且整个循环中不存在分支预测失败。
+ * 分块使得第二遍访问的元素仍在缓存中，并且桶的大小是固定的，不需要分配内存。
+ * 遇到valueless_by_exception的元素时抛出std::bad_variant_access，之前的分块已经被访问，所在的分块不会被访问。
+ * 需要注意，处理元素的顺序是分块内按类型分组后的顺序，而不是元素在序列中的顺序，因此BatchVisitor只适用于与处理顺序无关的访问者(例如统计、累加)。
+ */
+template<typename... Ts>
+class BatchVisitor{
+public:
+    using Variant = std::variant<Ts...>;
+    static constexpr std::size_t Chunk = 1024;
+
+    template<typename Ops>
+    void visit(Ops &ops, const Variant *first, std::size_t count){
+        for(std::size_t base = 0; base < count; base += Chunk){
+            const std::size_t n = (count - base < Chunk) ? count - base : Chunk;
+            const Variant *chunk = first + base;
+
+            m_sizes.fill(0);
+            for(std::size_t i = 0; i < n; ++i){
+                /* 与std::visit相同，valueless_by_exception的元素(index()为variant_npos)抛出std::bad_variant_access，此时分块中的元素都还没有被访问 */
+                const std::size_t type = chunk[i].index();
+                if(type >= sizeof...(Ts)) throw std::bad_variant_access();
+                m_buckets[type][m_sizes[type]++] = static_cast<std::uint16_t>(i);
+            }
+            visitBuckets(ops, chunk, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    template<typename Ops, typename Container>
+    void visit(Ops &ops, const Container &stream){
+        visit(ops, std::data(stream), std::size(stream));
+    }
+
+private:
+    template<typename Ops, std::size_t... I>
+    void visitBuckets(Ops &ops, const Variant *chunk, std::index_sequence<I...>){
+        (visitBucket<I>(ops, chunk), ...);
+    }
+
+    /* 桶中的元素都保存着第I个类型，因此std::get_if<I>中的类型检查总是成立 */
+    template<std::size_t I, typename Ops>
+    void visitBucket(Ops &ops, const Variant *chunk){
+        const std::uint16_t *bucket = m_buckets[I].data();
+        for(std::size_t j = 0; j < m_sizes[I]; ++j) ops(*std::get_if<I>(&chunk[bucket[j]]));
+    }
+
+    std::array<std::size_t, sizeof...(Ts)> m_sizes{};
+    std::array<std::array<std::uint16_t, Chunk>, sizeof...(Ts)> m_buckets;
+};
+
+template<typename Ops, typename... Ts>
+void visitBatched(Ops &ops, const std::vector<std::variant<Ts...>> &stream){
+    BatchVisitor<Ts...> visitor;
+    visitor.visit(ops, stream);
+}
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * 《逐个std::visit与BatchVisitor》
+ * 序列中包含10^7个variant，其可选类型的数量分别为2、4、8，每个元素的类型随机选取。访问者是由若干个Handler<K>组成的Overloader，每个Handler
+ * 累加对应类型的元素的值。
+ * 用法：bench_batch_visit.exe [元素数量]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "overloader.hpp"
+#include "batch_visit.hpp"
+
+template<int K>
+struct Alt{
+    int value;
+};
+
+template<int K>
+struct Handler{
+    long long sum = 0;
+    void operator() (const Alt<K> &alt) { sum += alt.value * (K + 1); }
+};
+
+template<typename Ops, int... K>
+long long total(const Ops &ops, std::integer_sequence<int, K...>){
+    return (static_cast<const Handler<K>&>(ops).sum + ...);
+}
+
+template<int... K>
+void run(std::integer_sequence<int, K...> seq, std::size_t n){
+    using Variant = std::variant<Alt<K>...>;
+    using Ops = Overloader<Handler<K>...>;
+    constexpr std::size_t alternatives = sizeof...(K);
+
+    /* 以随机的类型构造每个元素 */
+    const Variant prototypes[] = {Variant(std::in_place_index<K>, Alt<K>{K})...};
+    std::mt19937 rng(42);
+    std::vector<Variant> stream;
+    stream.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) stream.push_back(prototypes[rng() % alternatives]);
+
+    Ops perElement{};
+    auto begin = std::chrono::steady_clock::now();
+    for(const Variant &v : stream) std::visit(perElement, v);
+    std::chrono::duration<double, std::nano> visitNs = std::chrono::steady_clock::now() - begin;
+
+    Ops batched{};
+    BatchVisitor<Alt<K>...> visitor;
+    begin = std::chrono::steady_clock::now();
+    visitor.visit(batched, stream);
+    std::chrono::duration<double, std::nano> batchNs = std::chrono::steady_clock::now() - begin;
+
+    std::cout << alternatives << "\t" << visitNs.count() / n << "\t" << batchNs.count() / n
+              << "\t(check " << total(perElement, seq) << " " << total(batched, seq) << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::cout << "alternatives\tstd::visit(ns/elem)\tBatchVisitor(ns/elem)" << std::endl;
+    run(std::make_integer_sequence<int, 2>{}, n);
+    run(std::make_integer_sequence<int, 4>{}, n);
+    run(std::make_integer_sequence<int, 8>{}, n);
+}
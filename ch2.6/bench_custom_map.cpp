@@ -0,0 +1,69 @@
+/**
+ * 《CustomMap与std::unordered_map的插入/查找吞吐量》
+ * 键为形如“customer-000000000123”的Custom，其长度超过了std::string的小字符串缓冲区。std::unordered_map<Custom, V, CustomHash, CustomEq>在查找时
+ * 需要先构造一个临时的Custom，CustomMap则直接以std::string_view查找。
+ * 用法：bench_custom_map.exe [N1 N2 ...]，默认N为10^6和10^8
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "custom_map.hpp"
+
+std::string makeKey(std::size_t i){
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "customer-%012zu", i);
+    return buf;
+}
+
+double mops(std::size_t n, std::chrono::steady_clock::time_point begin){
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(n) / elapsed.count();
+}
+
+void run(std::size_t n){
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) keys.push_back(makeKey(i));
+
+    /* 查找顺序与插入顺序不同，避免按插入顺序访问带来的缓存优势 */
+    std::vector<std::size_t> order(n);
+    for(std::size_t i = 0; i < n; ++i) order[i] = (i * 7919) % n;
+
+    std::size_t sink = 0;
+    {
+        std::unordered_map<Custom, std::size_t, CustomHash, CustomEq> map;
+        auto begin = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < n; ++i) map.emplace(Custom(keys[i]), i);
+        double insert = mops(n, begin);
+
+        begin = std::chrono::steady_clock::now();
+        for(std::size_t i : order) sink += map.find(Custom(keys[i]))->second;
+        double lookup = mops(n, begin);
+        std::cout << "unordered_map\t" << n << "\t" << insert << "\t" << lookup << std::endl;
+    }
+    {
+        CustomMap<std::size_t> map;
+        auto begin = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < n; ++i) map.emplace(Custom(keys[i]), i);
+        double insert = mops(n, begin);
+
+        begin = std::chrono::steady_clock::now();
+        for(std::size_t i : order) sink += *map.find(std::string_view(keys[i]));
+        double lookup = mops(n, begin);
+        std::cout << "CustomMap\t" << n << "\t" << insert << "\t" << lookup << std::endl;
+    }
+    std::cout << "(sink " << sink << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::vector<std::size_t> sizes;
+    for(int i = 1; i < argc; ++i) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if(sizes.empty()) sizes = {1000000, 100000000};
+
+    std::cout << "map\tN\tinsert(M/s)\tlookup(M/s)" << std::endl;
+    for(std::size_t n : sizes) run(n);
+}
@@ -0,0 +1,272 @@
+#ifndef CUSTOM_MAP_HPP
+#define CUSTOM_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include "overloader.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * 《以Overloader作为哈希与比较函数的开放寻址哈希表》
+ * main.cpp中Overloader<CustomEq, CustomHash>将相等比较和哈希两个操作合并到了同一个对象中，FlatHashMap<Key, V, Ops>直接以这样的Overloader作为
+ * 模板参数Ops，通过重载决议从中选出所需的operator()：ops(key)计算哈希值，ops(key1, key2)比较是否相等。
+ *   1.每个元素的哈希值与键值保存在一起，扩容时无需重新计算哈希值；查找时先比较哈希值，只有哈希值相同时才调用ops比较键值。
+ *   2.元素保存在一段连续的数组中(开放寻址)，每16个槽位组成一组，每个槽位对应一个控制字节，保存该槽位的状态以及哈希值的低7位。查找时使用SSE2指令
+ *     一次比较一整组控制字节，从而同时排除一组中的16个槽位。
+ *   3.如果Ops中还提供了以其他类型(例如std::string_view)为参数的operator()，那么find和erase可以直接使用该类型的值进行查找，无需构造一个临时的Key。
+ *     此时要求两种类型对于相同的内容计算出相同的哈希值。
+ */
+
+/* 以std::string_view查找Custom时使用的哈希和比较操作，std::hash<std::string_view>与std::hash<std::string>对相同的字符序列返回相同的哈希值 */
+class CustomViewEq{
+public:
+    bool operator() (const Custom &lhs, std::string_view rhs) const{
+        return lhs.name() == rhs;
+    }
+};
+
+class CustomViewHash{
+public:
+    std::size_t operator() (std::string_view name) const{
+        return std::hash<std::string_view>()(name);
+    }
+};
+
+template<typename Key, typename V, typename Ops>
+class FlatHashMap{
+public:
+    struct Slot{
+        std::size_t hash;
+        Key key;
+        V value;
+    };
+
+    FlatHashMap() = default;
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    FlatHashMap(FlatHashMap &&other) noexcept { swap(other); }
+    FlatHashMap& operator=(FlatHashMap &&other) noexcept { FlatHashMap tmp(std::move(other)); swap(tmp); return *this; }
+    ~FlatHashMap() { release(); }
+
+    /* 插入键值对，如果键已经存在则不做修改。返回值的second表示是否插入了新元素 */
+    template<typename K, typename... Args>
+    std::pair<V*, bool> emplace(K &&key, Args&&... args);
+    std::pair<V*, bool> insert(const Key &key, const V &value) { return emplace(key, value); }
+
+    /* 查找成功时返回指向值的指针，否则返回nullptr。Lookup可以是Key，也可以是Ops支持的其他类型 */
+    template<typename Lookup>
+    V* find(const Lookup &key);
+    template<typename Lookup>
+    const V* find(const Lookup &key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    template<typename Lookup>
+    bool erase(const Lookup &key);
+
+    void reserve(std::size_t n);
+    std::size_t size() const      { return m_size; }
+    bool empty() const            { return m_size == 0; }
+    std::size_t capacity() const { return m_capacity; }
+
+    template<typename F>
+    void forEach(F f) const{
+        for(std::size_t i = 0; i < m_capacity; ++i){
+            if(isFull(m_ctrl[i])) f(m_slots[i].key, m_slots[i].value);
+        }
+    }
+
+    void swap(FlatHashMap &other) noexcept{
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_deleted, other.m_deleted);
+    }
+
+private:
+    static constexpr std::size_t GROUP = 16;
+    static constexpr std::int8_t EMPTY = -128;   //0x80
+    static constexpr std::int8_t DELETED = -2;   //0xFE
+
+    static bool isFull(std::int8_t c)    { return c >= 0; }
+    static std::int8_t h2(std::size_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+    static std::size_t h1(std::size_t hash) { return hash >> 7; }
+
+    /* 以位掩码的形式返回组内控制字节等于h的槽位、空槽位以及空或已删除的槽位 */
+    std::uint32_t matchByte(std::size_t group, std::int8_t h) const;
+    std::uint32_t matchEmpty(std::size_t group) const          { return matchByte(group, EMPTY); }
+    std::uint32_t matchEmptyOrDeleted(std::size_t group) const;
+
+    template<typename Lookup>
+    std::size_t findIndex(const Lookup &key, std::size_t hash) const;
+    std::size_t findInsertIndex(std::size_t hash) const;
+    void rehash(std::size_t newCapacity);
+    void release() noexcept;
+
+    std::int8_t *m_ctrl = nullptr;
+    Slot *m_slots = nullptr;
+    std::size_t m_capacity = 0;   //槽位数量，总是GROUP的2的幂倍
+    std::size_t m_size = 0;
+    std::size_t m_deleted = 0;
+    [[no_unique_address]] Ops m_ops;
+};
+
+template<typename Key, typename V, typename Ops>
+std::uint32_t FlatHashMap<Key,V,Ops>::matchByte(std::size_t group, std::int8_t h) const{
+    const std::int8_t *ctrl = m_ctrl + group * GROUP;
+#if defined(__SSE2__)
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h))));
+#else
+    std::uint32_t mask = 0;
+    for(std::size_t i = 0; i < GROUP; ++i) mask |= static_cast<std::uint32_t>(ctrl[i] == h) << i;
+    return mask;
+#endif
+}
+
+/* EMPTY和DELETED的最高位都是1，而已占用槽位的控制字节在0到127之间，因此只需检查每个字节的最高位 */
+template<typename Key, typename V, typename Ops>
+std::uint32_t FlatHashMap<Key,V,Ops>::matchEmptyOrDeleted(std::size_t group) const{
+    const std::int8_t *ctrl = m_ctrl + group * GROUP;
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+    std::uint32_t mask = 0;
+    for(std::size_t i = 0; i < GROUP; ++i) mask |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+    return mask;
+#endif
+}
+
+/* 按照1、2、3...的步长在组之间探测，当组的数量是2的幂时，这个序列可以访问到每一组 */
+template<typename Key, typename V, typename Ops>
+  template<typename Lookup>
+std::size_t FlatHashMap<Key,V,Ops>::findIndex(const Lookup &key, std::size_t hash) const{
+    if(m_capacity == 0) return m_capacity;
+
+    const std::size_t groupMask = m_capacity / GROUP - 1;
+    std::size_t group = h1(hash) & groupMask;
+    for(std::size_t step = 1; ; ++step){
+        for(std::uint32_t match = matchByte(group, h2(hash)); match; match &= match - 1){
+            const std::size_t index = group * GROUP + static_cast<std::size_t>(__builtin_ctz(match));
+            if(m_slots[index].hash == hash && m_ops(m_slots[index].key, key)) return index;
+        }
+        if(matchEmpty(group)) return m_capacity;
+        group = (group + step) & groupMask;
+    }
+}
+
+template<typename Key, typename V, typename Ops>
+std::size_t FlatHashMap<Key,V,Ops>::findInsertIndex(std::size_t hash) const{
+    const std::size_t groupMask = m_capacity / GROUP - 1;
+    std::size_t group = h1(hash) & groupMask;
+    for(std::size_t step = 1; ; ++step){
+        if(std::uint32_t free = matchEmptyOrDeleted(group)){
+            return group * GROUP + static_cast<std::size_t>(__builtin_ctz(free));
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+template<typename Key, typename V, typename Ops>
+  template<typename K, typename... Args>
+std::pair<V*, bool> FlatHashMap<Key,V,Ops>::emplace(K &&key, Args&&... args){
+    const std::size_t hash = m_ops(key);
+    std::size_t index = findIndex(key, hash);
+    if(index != m_capacity) return {&m_slots[index].value, false};
+
+    /* 已占用和已删除的槽位总数超过容量的7/8时扩容；如果主要是已删除的槽位，则以相同的容量重建以清除它们 */
+    if((m_size + m_deleted + 1) * 8 > m_capacity * 7){
+        rehash((m_size + 1) * 8 > m_capacity * 4 ? (m_capacity ? m_capacity * 2 : GROUP) : m_capacity);
+    }
+
+    index = findInsertIndex(hash);
+    ::new(static_cast<void*>(&m_slots[index])) Slot{hash, Key(std::forward<K>(key)), V(std::forward<Args>(args)...)};
+    if(m_ctrl[index] == DELETED) --m_deleted;
+    m_ctrl[index] = h2(hash);
+    ++m_size;
+    return {&m_slots[index].value, true};
+}
+
+template<typename Key, typename V, typename Ops>
+  template<typename Lookup>
+V* FlatHashMap<Key,V,Ops>::find(const Lookup &key){
+    const std::size_t index = findIndex(key, m_ops(key));
+    return index == m_capacity ? nullptr : &m_slots[index].value;
+}
+
+/**
+ * 如果被删除的槽位所在的组中还有空槽位，说明这一组从未被占满过，也就不会有探测经过这一组继续向后查找，此时可以直接将其标记为空；
+ * 否则必须标记为已删除，以免截断经过这一组的探测序列。
+ */
+template<typename Key, typename V, typename Ops>
+  template<typename Lookup>
+bool FlatHashMap<Key,V,Ops>::erase(const Lookup &key){
+    const std::size_t index = findIndex(key, m_ops(key));
+    if(index == m_capacity) return false;
+
+    m_slots[index].~Slot();
+    if(matchEmpty(index / GROUP)){
+        m_ctrl[index] = EMPTY;
+    }else{
+        m_ctrl[index] = DELETED;
+        ++m_deleted;
+    }
+    --m_size;
+    return true;
+}
+
+template<typename Key, typename V, typename Ops>
+void FlatHashMap<Key,V,Ops>::reserve(std::size_t n){
+    std::size_t capacity = m_capacity ? m_capacity : GROUP;
+    while(n * 8 > capacity * 7) capacity *= 2;
+    if(capacity != m_capacity) rehash(capacity);
+}
+
+/* 重建时直接使用保存的哈希值确定新位置，不会再调用ops计算哈希值 */
+template<typename Key, typename V, typename Ops>
+void FlatHashMap<Key,V,Ops>::rehash(std::size_t newCapacity){
+    FlatHashMap next;
+    next.m_ctrl = std::allocator<std::int8_t>().allocate(newCapacity);
+    std::memset(next.m_ctrl, EMPTY, newCapacity);
+    next.m_slots = std::allocator<Slot>().allocate(newCapacity);
+    next.m_capacity = newCapacity;
+
+    for(std::size_t i = 0; i < m_capacity; ++i){
+        if(!isFull(m_ctrl[i])) continue;
+        const std::size_t index = next.findInsertIndex(m_slots[i].hash);
+        ::new(static_cast<void*>(&next.m_slots[index])) Slot(std::move(m_slots[i]));
+        next.m_ctrl[index] = m_ctrl[i];
+        ++next.m_size;
+    }
+
+    swap(next);
+}
+
+template<typename Key, typename V, typename Ops>
+void FlatHashMap<Key,V,Ops>::release() noexcept{
+    for(std::size_t i = 0; i < m_capacity; ++i){
+        if(isFull(m_ctrl[i])) m_slots[i].~Slot();
+    }
+    if(m_capacity){
+        std::allocator<std::int8_t>().deallocate(m_ctrl, m_capacity);
+        std::allocator<Slot>().deallocate(m_slots, m_capacity);
+    }
+    m_ctrl = nullptr;
+    m_slots = nullptr;
+    m_capacity = m_size = m_deleted = 0;
+}
+
+/* 以Custom为键的哈希表，Ops同时支持以Custom和std::string_view查找 */
+using CustomMapOps = Overloader<CustomEq, CustomHash, CustomViewEq, CustomViewHash>;
+
+template<typename V>
+using CustomMap = FlatHashMap<Custom, V, CustomMapOps>;
+
+#endif
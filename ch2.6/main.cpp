@@ -4,6 +4,7 @@
  * 2.可以在类模板的继承中使用可变表达式，以此让该模板可以继承类型可变、数量可变的基类
  */
 #include <iostream>
+#include "overloader.hpp"
 
 //================================
 /**
@@ -32,44 +33,7 @@ void func1(){
  * 通过指定不同数量、类型的基类作为类型参数，我们就可以让Overloader继承相应的基类。
  */
 
-template<typename... Bases>
-class Overloader : public Bases...{  //对继承操作使用可变表达式，Overloader就可继承参数包中的所有类型。即展开为Overloader : public Base1, Base2, Base3
-public:
-    using Bases::operator()...;           //对using声明使用可变表达式，从而引入参数包中每个基类的operator()操作符
-};
-
-/**
- * 以下是拥有可变基类的Overloader模板结合using声明的一种用途，我们将通过Overloader模板将CustomEq和CustomHash两个类型的operator()操作符
- * 合并到Overloader实例中。
- */
-class Custom{
-public:
-    Custom(const std::string &name) : m_name(name){}
-    std::string name() const { return m_name; }
-private:
-    std::string m_name;
-};
-
-class CustomEq{
-public:
-    bool operator() (const Custom &lhs, const Custom &rhs) const{
-        return lhs.name() == rhs.name();
-    }
-};
-
-class CustomHash{
-public:
-    std::size_t operator() (const Custom &custom) const{
-        return std::hash<std::string>()(custom.name());
-    }
-};
-
-class CustomSize{
-public:
-    std::size_t operator() (const Custom &custom) const{
-        return custom.name().size();
-    }
-};
+/* Overloader以及Custom、CustomEq、CustomHash、CustomSize的定义见overloader.hpp */
 
 void func2(){
     /**
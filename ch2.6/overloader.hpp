@@ -0,0 +1,46 @@
+#ifndef OVERLOADER_HPP
+#define OVERLOADER_HPP
+
+#include <functional>
+#include <string>
+
+template<typename... Bases>
+class Overloader : public Bases...{  //对继承操作使用可变表达式，Overloader就可继承参数包中的所有类型。即展开为Overloader : public Base1, Base2, Base3
+public:
+    using Bases::operator()...;           //对using声明使用可变表达式，从而引入参数包中每个基类的operator()操作符
+};
+
+/**
+ * 以下是拥有可变基类的Overloader模板结合using声明的一种用途，我们将通过Overloader模板将CustomEq和CustomHash两个类型的operator()操作符
+ * 合并到Overloader实例中。
+ */
+class Custom{
+public:
+    Custom(const std::string &name) : m_name(name){}
+    const std::string& name() const { return m_name; }  //返回引用，避免每次调用都拷贝字符串
+private:
+    std::string m_name;
+};
+
+class CustomEq{
+public:
+    bool operator() (const Custom &lhs, const Custom &rhs) const{
+        return lhs.name() == rhs.name();
+    }
+};
+
+class CustomHash{
+public:
+    std::size_t operator() (const Custom &custom) const{
+        return std::hash<std::string>()(custom.name());
+    }
+};
+
+class CustomSize{
+public:
+    std::size_t operator() (const Custom &custom) const{
+        return custom.name().size();
+    }
+};
+
+#endif
\ No newline at end of file
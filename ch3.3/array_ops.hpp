@@ -0,0 +1,322 @@
+#ifndef ARRAY_OPS_HPP
+#define ARRAY_OPS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * 《以数组长度特化的数组算法》
+ * main.cpp中的printArray(T (&array)[N])通过引用保留了数组的类型，因此N在编译时就是已知的，但它仍然像处理长度未知的数组那样在运行时逐个循环。
+ * 这里的算法同样以引用接收数组，并利用编译时已知的N和sizeof(T)选择实现：
+ *   1.arraySum、arrayMin、arrayMax、arrayMinMax、arrayEqual、arrayCopy、arrayFind同时接受C风格数组T[N]和std::array<T, N>，两者通过ArrayTraits
+ *     得到相同的元素类型和长度。
+ *   2.对于算术类型，整个数组的字节数决定了向量的宽度：不足16字节时逐个元素完全展开；否则使用16字节的向量；以-mavx2编译并且不少于64字节时使用32字节的
+ *     向量。向量通过GCC的vector_size扩展表示，宽度不超过目标指令集原生支持的宽度，否则编译器只能以多条较窄的指令甚至逐个通道地模拟向量运算。
+ *     arrayFind以及浮点数的arrayEqual将向量比较的结果通过movemask转换为整数掩码，从而以一次分支判断整个向量中是否存在相等(或不等)的元素。
+ *   3.向量无法覆盖的尾部元素个数N % L同样是编译时常量，这些元素以展开的形式处理，不存在尾部循环。
+ *   4.其他类型的元素在N不超过UNROLL_LIMIT时完全展开，否则使用普通循环，arrayEqual和arrayCopy对可以平凡拷贝的整数类型使用长度为常量的memcmp和memcpy。
+ * 需要注意，浮点数的向量求和改变了相加顺序，因此结果可能与逐个相加的结果存在舍入误差上的差异。
+ */
+
+template<typename A>
+struct ArrayTraits;
+
+template<typename T, std::size_t N>
+struct ArrayTraits<T[N]>{
+    using value_type = T;
+    static constexpr std::size_t size = N;
+};
+
+template<typename T, std::size_t N>
+struct ArrayTraits<std::array<T, N>>{
+    using value_type = T;
+    static constexpr std::size_t size = N;
+};
+
+template<typename A>
+struct ArrayTraits<const A> : ArrayTraits<A>{};
+
+template<typename A>
+using ArrayValue = typename ArrayTraits<std::remove_reference_t<A>>::value_type;
+
+template<typename A>
+constexpr std::size_t arraySize = ArrayTraits<std::remove_reference_t<A>>::size;
+
+template<typename T, std::size_t N>
+constexpr T* arrayData(T (&array)[N]) { return array; }
+
+template<typename T, std::size_t N>
+constexpr const T* arrayData(const std::array<T, N> &array) { return array.data(); }
+
+template<typename T, std::size_t N>
+constexpr T* arrayData(std::array<T, N> &array) { return array.data(); }
+
+constexpr std::size_t UNROLL_LIMIT = 16;
+
+//===============向量宽度===============
+template<typename T>
+constexpr bool vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+#if defined(__AVX2__)
+constexpr std::size_t NATIVE_VECTOR_BYTES = 32;
+#else
+constexpr std::size_t NATIVE_VECTOR_BYTES = 16;
+#endif
+
+/* 以字节计的向量宽度，0表示不使用向量 */
+template<typename T, std::size_t N>
+constexpr std::size_t vectorBytes(){
+    if constexpr (!vectorizable<T>) return 0;
+    else{
+        constexpr std::size_t bytes = N * sizeof(T);
+        if(bytes >= 64 && NATIVE_VECTOR_BYTES >= 32) return 32;
+        if(bytes >= 16) return 16;
+        return 0;
+    }
+}
+
+template<typename T, std::size_t Bytes>
+struct VectorOf{
+    typedef T type __attribute__((vector_size(Bytes)));
+    static constexpr std::size_t lanes = Bytes / sizeof(T);
+
+    static type load(const T *p){
+        type v;
+        std::memcpy(&v, p, Bytes);
+        return v;
+    }
+
+    static type splat(T value){
+        type v;
+        for(std::size_t i = 0; i < lanes; ++i) v[i] = value;
+        return v;
+    }
+
+    /* 比较结果的每个通道为全0或全1，返回每个字节的最高位组成的掩码，即每个通道对应sizeof(T)个连续的位 */
+    template<typename M>
+    static std::uint32_t mask(M cmp){
+#if defined(__AVX2__)
+        if constexpr (Bytes == 32) return static_cast<std::uint32_t>(_mm256_movemask_epi8(reinterpret_cast<__m256i>(cmp)));
+#endif
+#if defined(__SSE2__)
+        if constexpr (Bytes == 16) return static_cast<std::uint32_t>(_mm_movemask_epi8(reinterpret_cast<__m128i>(cmp)));
+#endif
+        std::uint32_t bits = 0;
+        for(std::size_t i = 0; i < lanes; ++i){
+            if(cmp[i]) bits |= ((std::uint32_t{1} << sizeof(T)) - 1) << (i * sizeof(T));
+        }
+        return bits;
+    }
+};
+
+/* 对0, 1, ..., Count - 1中的每个I调用f(Offset + I)，调用在编译时完全展开 */
+template<std::size_t Offset, std::size_t Count, typename F>
+constexpr void unrolled(F &&f){
+    [&]<std::size_t... I>(std::index_sequence<I...>){
+        (f(Offset + I), ...);
+    }(std::make_index_sequence<Count>{});
+}
+
+//===============sum===============
+template<typename T, std::size_t N>
+T sumN(const T *p){
+    constexpr std::size_t W = vectorBytes<T, N>();
+    if constexpr (W == 0 && N <= UNROLL_LIMIT){
+        T sum{};
+        unrolled<0, N>([&](std::size_t i){ sum += p[i]; });
+        return sum;
+    }else if constexpr (W == 0){
+        T sum{};
+        for(std::size_t i = 0; i < N; ++i) sum += p[i];
+        return sum;
+    }else{
+        using VT = VectorOf<T, W>;
+        constexpr std::size_t L = VT::lanes;
+        constexpr std::size_t BODY = N / L * L;
+
+        /* 两个相互独立的累加器，使相邻的加法指令之间没有数据依赖 */
+        typename VT::type acc0{}, acc1{};
+        std::size_t i = 0;
+        #pragma GCC unroll 4
+        for(; i + 2 * L <= BODY; i += 2 * L){
+            acc0 += VT::load(p + i);
+            acc1 += VT::load(p + i + L);
+        }
+        if constexpr (BODY % (2 * L) != 0) acc0 += VT::load(p + BODY - L);
+        acc0 += acc1;
+
+        T sum{};
+        unrolled<0, L>([&](std::size_t lane){ sum += acc0[lane]; });
+        unrolled<BODY, N - BODY>([&](std::size_t j){ sum += p[j]; });
+        return sum;
+    }
+}
+
+template<typename A>
+ArrayValue<A> arraySum(const A &array){
+    return sumN<ArrayValue<A>, arraySize<A>>(arrayData(array));
+}
+
+//===============min/max===============
+template<typename T, std::size_t N>
+std::pair<T, T> minMaxN(const T *p){
+    static_assert(N > 0, "min/max of an empty array is undefined");
+    constexpr std::size_t W = vectorBytes<T, N>();
+    if constexpr (W == 0){
+        T lo = p[0], hi = p[0];
+        if constexpr (N <= UNROLL_LIMIT){
+            unrolled<1, N - 1>([&](std::size_t i){
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            });
+        }else{
+            for(std::size_t i = 1; i < N; ++i){
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            }
+        }
+        return {lo, hi};
+    }else{
+        using VT = VectorOf<T, W>;
+        constexpr std::size_t L = VT::lanes;
+        constexpr std::size_t BODY = N / L * L;
+
+        typename VT::type lo = VT::load(p), hi = lo;
+        #pragma GCC unroll 4
+        for(std::size_t i = L; i < BODY; i += L){
+            const typename VT::type v = VT::load(p + i);
+            lo = v < lo ? v : lo;
+            hi = hi < v ? v : hi;
+        }
+
+        T l = lo[0], h = hi[0];
+        unrolled<1, L - 1>([&](std::size_t lane){
+            l = lo[lane] < l ? lo[lane] : l;
+            h = h < hi[lane] ? hi[lane] : h;
+        });
+        unrolled<BODY, N - BODY>([&](std::size_t j){
+            l = p[j] < l ? p[j] : l;
+            h = h < p[j] ? p[j] : h;
+        });
+        return {l, h};
+    }
+}
+
+template<typename A>
+std::pair<ArrayValue<A>, ArrayValue<A>> arrayMinMax(const A &array){
+    return minMaxN<ArrayValue<A>, arraySize<A>>(arrayData(array));
+}
+
+template<typename A>
+ArrayValue<A> arrayMin(const A &array) { return arrayMinMax(array).first; }
+
+template<typename A>
+ArrayValue<A> arrayMax(const A &array) { return arrayMinMax(array).second; }
+
+//===============equal===============
+/* 整数以及指针可以按字节比较；浮点数不可以，因为+0.0与-0.0相等而NaN与自身不相等 */
+template<typename T>
+constexpr bool bytewiseComparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template<typename T, std::size_t N>
+bool equalN(const T *a, const T *b){
+    constexpr std::size_t W = vectorBytes<T, N>();
+    if constexpr (bytewiseComparable<T>){
+        return std::memcmp(a, b, N * sizeof(T)) == 0;
+    }else if constexpr (W != 0){
+        using VT = VectorOf<T, W>;
+        constexpr std::size_t L = VT::lanes;
+        constexpr std::size_t BODY = N / L * L;
+
+        for(std::size_t i = 0; i < BODY; i += L){
+            if(VT::mask(VT::load(a + i) != VT::load(b + i)) != 0) return false;
+        }
+        bool same = true;
+        unrolled<BODY, N - BODY>([&](std::size_t i){ same = same && a[i] == b[i]; });
+        return same;
+    }else if constexpr (N <= UNROLL_LIMIT){
+        bool same = true;
+        unrolled<0, N>([&](std::size_t i){ same = same && a[i] == b[i]; });
+        return same;
+    }else{
+        for(std::size_t i = 0; i < N; ++i){
+            if(!(a[i] == b[i])) return false;
+        }
+        return true;
+    }
+}
+
+template<typename A, typename B>
+bool arrayEqual(const A &a, const B &b){
+    static_assert(std::is_same_v<ArrayValue<A>, ArrayValue<B>>, "arrays must have the same element type");
+    if constexpr (arraySize<A> != arraySize<B>) return false;
+    else return equalN<ArrayValue<A>, arraySize<A>>(arrayData(a), arrayData(b));
+}
+
+//===============copy===============
+template<typename T, std::size_t N>
+void copyN(T *dest, const T *src){
+    if constexpr (std::is_trivially_copyable_v<T>){
+        std::memcpy(dest, src, N * sizeof(T));
+    }else if constexpr (N <= UNROLL_LIMIT){
+        unrolled<0, N>([&](std::size_t i){ dest[i] = src[i]; });
+    }else{
+        for(std::size_t i = 0; i < N; ++i) dest[i] = src[i];
+    }
+}
+
+template<typename D, typename S>
+void arrayCopy(D &dest, const S &src){
+    static_assert(std::is_same_v<ArrayValue<D>, ArrayValue<S>>, "arrays must have the same element type");
+    static_assert(arraySize<D> >= arraySize<S>, "destination array is too small");
+    copyN<ArrayValue<S>, arraySize<S>>(arrayData(dest), arrayData(src));
+}
+
+//===============find===============
+/* 返回第一个等于value的元素的下标，不存在时返回N */
+template<typename T, std::size_t N>
+std::size_t findN(const T *p, T value){
+    constexpr std::size_t W = vectorBytes<T, N>();
+    if constexpr (W == 0 && N <= UNROLL_LIMIT){
+        std::size_t found = N;
+        unrolled<0, N>([&](std::size_t i){
+            if(found == N && p[i] == value) found = i;
+        });
+        return found;
+    }else if constexpr (W == 0){
+        for(std::size_t i = 0; i < N; ++i){
+            if(p[i] == value) return i;
+        }
+        return N;
+    }else{
+        using VT = VectorOf<T, W>;
+        constexpr std::size_t L = VT::lanes;
+        constexpr std::size_t BODY = N / L * L;
+
+        const typename VT::type key = VT::splat(value);
+        for(std::size_t i = 0; i < BODY; i += L){
+            const std::uint32_t bits = VT::mask(VT::load(p + i) == key);
+            if(bits != 0) return i + static_cast<std::size_t>(__builtin_ctz(bits)) / sizeof(T);
+        }
+        std::size_t found = N;
+        unrolled<BODY, N - BODY>([&](std::size_t j){
+            if(found == N && p[j] == value) found = j;
+        });
+        return found;
+    }
+}
+
+template<typename A>
+std::size_t arrayFind(const A &array, const ArrayValue<A> &value){
+    return findN<ArrayValue<A>, arraySize<A>>(arrayData(array), value);
+}
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * 《运行时循环与以长度特化的数组算法》
+ * 对N ∈ {4, 8, 16, 64, 1024}、元素类型为int和float的std::array，分别以运行时长度的循环(与main.cpp中例3的printArray相同，N只在运行时使用)和
+ * array_ops.hpp中的算法执行sum、min/max、equal、copy、find，输出每次调用的平均耗时。数据总量为64K个元素，可以放入L2缓存，每轮依次处理其中的每个数组，
+ * 以免编译器将调用移出循环。
+ * 用法：bench_array_ops.exe [每种组合处理的元素总数]
+ */
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "array_ops.hpp"
+
+//===============运行时循环===============
+/* noipa阻止编译器将常量长度传播到函数内部，使n保持为真正的运行时参数 */
+#define RUNTIME __attribute__((noipa))
+
+template<typename T>
+RUNTIME T loopSum(const T *p, std::size_t n){
+    T sum{};
+    for(std::size_t i = 0; i < n; ++i) sum += p[i];
+    return sum;
+}
+
+template<typename T>
+RUNTIME std::pair<T, T> loopMinMax(const T *p, std::size_t n){
+    T lo = p[0], hi = p[0];
+    for(std::size_t i = 1; i < n; ++i){
+        lo = p[i] < lo ? p[i] : lo;
+        hi = hi < p[i] ? p[i] : hi;
+    }
+    return {lo, hi};
+}
+
+template<typename T>
+RUNTIME bool loopEqual(const T *a, const T *b, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i){
+        if(!(a[i] == b[i])) return false;
+    }
+    return true;
+}
+
+template<typename T>
+RUNTIME void loopCopy(T *dest, const T *src, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i) dest[i] = src[i];
+}
+
+template<typename T>
+RUNTIME std::size_t loopFind(const T *p, std::size_t n, T value){
+    for(std::size_t i = 0; i < n; ++i){
+        if(p[i] == value) return i;
+    }
+    return n;
+}
+
+//===============计时===============
+template<typename F>
+double timeNs(std::size_t calls, F &&f){
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - begin;
+    return ns.count() / calls;
+}
+
+template<typename T, std::size_t N>
+void run(const char *type, std::size_t total){
+    using Array = std::array<T, N>;
+    const std::size_t count = N >= 65536 ? 1 : 65536 / N;
+    const std::size_t rounds = total / (count * N) + 1;
+    const std::size_t calls = rounds * count;
+
+    std::mt19937 rng(42);
+    std::vector<Array> data(count), same(count), dest(count);
+    for(Array &a : data){
+        for(T &x : a) x = static_cast<T>(rng() % 1000);
+    }
+    same = data;
+
+    auto report = [&](const char *op, double loop, double special, double check){
+        std::cout << type << "\t" << N << "\t" << op << "\t" << loop << "\t" << special << "\t(check " << check << ")" << std::endl;
+    };
+
+    double a = 0, b = 0;
+    double loop = timeNs(calls, [&]{ for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data) a += loopSum(x.data(), N); });
+    double special = timeNs(calls, [&]{ for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data) b += arraySum(x); });
+    report("sum", loop, special, a - b);
+
+    a = b = 0;
+    loop = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data){ auto m = loopMinMax(x.data(), N); a += m.second - m.first; }
+    });
+    special = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data){ auto m = arrayMinMax(x); b += m.second - m.first; }
+    });
+    report("minmax", loop, special, a - b);
+
+    a = b = 0;
+    loop = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(std::size_t i = 0; i < count; ++i) a += loopEqual(data[i].data(), same[i].data(), N);
+    });
+    special = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(std::size_t i = 0; i < count; ++i) b += arrayEqual(data[i], same[i]);
+    });
+    report("equal", loop, special, a - b);
+
+    loop = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(std::size_t i = 0; i < count; ++i) loopCopy(dest[i].data(), data[(i + r) % count].data(), N);
+    });
+    a = static_cast<double>(dest[0][0]);
+    special = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(std::size_t i = 0; i < count; ++i) arrayCopy(dest[i], data[(i + r) % count]);
+    });
+    b = static_cast<double>(dest[0][0]);
+    report("copy", loop, special, a - b);
+
+    /* 查找每个数组的最后一个元素，因此需要扫描整个数组 */
+    a = b = 0;
+    loop = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data) a += loopFind(x.data(), N, x[N - 1]);
+    });
+    special = timeNs(calls, [&]{
+        for(std::size_t r = 0; r < rounds; ++r) for(const Array &x : data) b += arrayFind(x, x[N - 1]);
+    });
+    report("find", loop, special, a - b);
+}
+
+template<typename T, std::size_t... N>
+void runAll(const char *type, std::size_t total, std::index_sequence<N...>){
+    (run<T, N>(type, total), ...);
+}
+
+int main(int argc, char *argv[]){
+    std::size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+    std::cout << "type\tN\top\tloop(ns/call)\tarray_ops(ns/call)" << std::endl;
+    runAll<int>("int", total, std::index_sequence<4, 8, 16, 64, 1024>{});
+    runAll<float>("float", total, std::index_sequence<4, 8, 16, 64, 1024>{});
+}
@@ -0,0 +1,89 @@
+/**
+ * 《请求级内存池的延迟分布》
+ * 每个请求创建STACKS个栈：一半是Stack<int>，另一半是AssignedStack<int>，每个栈压入1到64个随机数量的元素，然后将每个AssignedStack<int>赋值给一个
+ * AssignedStack<long>。请求结束时所有栈被销毁，使用RequestArena的版本还会调用一次reset。分别统计默认分配器(malloc)和RequestArena两种情况下每个请求
+ * 耗时的p50和p99，其中RequestArena又分为直接使用单调缓冲区(resource())和使用其上的内存池(pool())两种情况。
+ * 用法：bench_arena.exe [请求数] [每个请求的栈数]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "stack.hpp"
+#include "request_arena.hpp"
+
+static long long g_sink = 0;
+
+void mallocRequest(const std::vector<int> &sizes){
+    std::vector<Stack<int>> stacks(sizes.size() / 2);
+    std::vector<AssignedStack<int>> assigned(sizes.size() - stacks.size());
+    std::vector<AssignedStack<long>> converted(assigned.size());
+
+    for(std::size_t i = 0; i < stacks.size(); ++i){
+        for(int k = 0; k < sizes[i]; ++k) stacks[i].push(k);
+        g_sink += stacks[i].top();
+    }
+    for(std::size_t i = 0; i < assigned.size(); ++i){
+        for(int k = 0; k < sizes[stacks.size() + i]; ++k) assigned[i].push(k);
+        converted[i] = assigned[i];
+        g_sink += converted[i].top();
+    }
+}
+
+void arenaRequest(const std::vector<int> &sizes, RequestArena &arena, std::pmr::memory_resource *res){
+    {
+        std::pmr::vector<PmrStack<int>> stacks(res);
+        std::pmr::vector<PmrAssignedStack<int>> assigned(res);
+        std::pmr::vector<PmrAssignedStack<long>> converted(res);
+        stacks.reserve(sizes.size() / 2);
+        assigned.reserve(sizes.size() - sizes.size() / 2);
+        converted.reserve(assigned.capacity());
+
+        for(std::size_t i = 0; i < sizes.size() / 2; ++i){
+            PmrStack<int> &s = stacks.emplace_back();     //std::pmr::vector通过使用分配器构造将res传递给Stack
+            for(int k = 0; k < sizes[i]; ++k) s.push(k);
+            g_sink += s.top();
+        }
+        for(std::size_t i = sizes.size() / 2; i < sizes.size(); ++i){
+            PmrAssignedStack<int> &a = assigned.emplace_back(res);
+            for(int k = 0; k < sizes[i]; ++k) a.push(k);
+            PmrAssignedStack<long> &c = converted.emplace_back(res);
+            c = a;
+            g_sink += c.top();
+        }
+    }
+    arena.reset();
+}
+
+template<typename F>
+void measure(const char *name, std::size_t requests, F run){
+    std::vector<double> latencies(requests);
+    for(std::size_t r = 0; r < requests; ++r){
+        auto begin = std::chrono::steady_clock::now();
+        run(r);
+        latencies[r] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << name << "\tp50 " << latencies[requests / 2] << " us\tp99 " << latencies[requests * 99 / 100] << " us" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t requests = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    std::size_t stacks = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+    /* 两种情况使用相同的栈大小序列 */
+    std::mt19937 rng(42);
+    std::vector<std::vector<int>> sizes(requests, std::vector<int>(stacks));
+    for(std::vector<int> &request : sizes){
+        for(int &n : request) n = 1 + static_cast<int>(rng() % 64);
+    }
+
+    RequestArena arena(8 * 1024 * 1024);
+    measure("malloc          ", requests, [&](std::size_t r){ mallocRequest(sizes[r]); });
+    measure("arena resource()", requests, [&](std::size_t r){ arenaRequest(sizes[r], arena, arena.resource()); });
+    measure("arena pool()    ", requests, [&](std::size_t r){ arenaRequest(sizes[r], arena, arena.pool()); });
+    std::cout << "(sink " << g_sink << ")" << std::endl;
+}
@@ -0,0 +1,61 @@
+/**
+ * 《AssignedStack转换赋值的开销》
+ * 将一个含有10^6个int的AssignedStack<int>赋值给AssignedStack<float>，比较最初的“先拷贝、再逐个top()/pop()并push_front”的做法与stack.hpp中
+ * 一次遍历完成的operator=，同时测试T与T2相同时，移动赋值接管存储空间的开销。
+ * 用法：bench_assign.exe [元素数量] [重复次数]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include "stack.hpp"
+
+/* 最初版本operator=的做法，由于无法访问AssignedStack的私有成员，这里将结果写入一个独立的deque，两者的开销相同 */
+void legacyAssign(std::deque<float> &dest, const AssignedStack<int> &other){
+    AssignedStack<int> cpy(other);
+    dest.clear();
+
+    while(!cpy.empty()){
+        dest.push_front(cpy.top());
+        cpy.pop();
+    }
+}
+
+template<typename F>
+double measure(std::size_t repeat, F f){
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < repeat; ++i) f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / repeat;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t repeat = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    AssignedStack<int> istack;
+    for(std::size_t i = 0; i < count; ++i) istack.push(static_cast<int>(i));
+
+    std::deque<float> legacy;
+    double legacyMs = measure(repeat, [&]{ legacyAssign(legacy, istack); });
+
+    AssignedStack<float> fstack;
+    double assignMs = measure(repeat, [&]{ fstack = istack; });
+
+    double convertMs = measure(repeat, [&]{ AssignedStack<float> converted(istack); });
+
+    /* 移动赋值只测量赋值本身，不包括创建源对象的拷贝 */
+    double moveMs = 0;
+    for(std::size_t i = 0; i < repeat; ++i){
+        AssignedStack<int> src(istack), dest;
+        moveMs += measure(1, [&]{ dest = std::move(src); });
+    }
+    moveMs /= repeat;
+
+    std::cout << "elements: " << count << std::endl;
+    std::cout << "legacy copy-then-pop:      " << legacyMs << " ms" << std::endl;
+    std::cout << "operator=(const&) int->float: " << assignMs << " ms" << std::endl;
+    std::cout << "converting constructor:    " << convertMs << " ms" << std::endl;
+    std::cout << "operator=(&&) same type:   " << moveMs << " ms" << std::endl;
+    std::cout << "check: " << legacy.back() << " " << fstack.top() << std::endl;
+}
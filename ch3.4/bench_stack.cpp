@@ -0,0 +1,71 @@
+/**
+ * 《三种Stack的分配次数与push/pop延迟》
+ * 比较stack.hpp中的Stack<T>、ch2.1中的Stack<T, Size>以及small_stack.hpp中的SmallStack<T, InlineN>。每一轮创建一个新的栈，压入k个元素后再全部弹出：
+ *   1.small：k在1到16之间，三种Stack都可以容纳。
+ *   2.mixed：每1000个栈中有一个栈压入4096个元素，Stack<T, Size>无法容纳这么多元素，因此不参与该测试。
+ * 用法：bench_stack.exe [栈的数量]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "stack.hpp"
+#include "small_stack.hpp"
+
+/* ch2.1的Stack<T, Size>与本章的Stack<T>是同名但模板参数不同的两个类模板，不能在同一个作用域中声明，因此将其包含在命名空间fixed中。该头文件不包含其他头文件 */
+namespace fixed{
+#include "../ch2.1/stack.hpp"
+}
+
+//===============分配计数===============
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size){
+    ++g_allocations;
+    if(void *p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept                   { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+//===============测试===============
+std::size_t elementsOf(std::size_t round, bool mixed){
+    if(mixed && round % 1000 == 0) return 4096;
+    return round % 16 + 1;
+}
+
+template<typename S>
+void run(const char *name, std::size_t rounds, bool mixed){
+    std::size_t ops = 0;
+    long long sink = 0;
+    std::size_t allocBefore = g_allocations;
+
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t r = 0; r < rounds; ++r){
+        S stack;
+        std::size_t k = elementsOf(r, mixed);
+        for(std::size_t i = 0; i < k; ++i) stack.push(static_cast<int>(i));
+        for(std::size_t i = 0; i < k; ++i){
+            sink += stack.top();
+            stack.pop();
+        }
+        ops += 2 * k;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+
+    std::cout << name << "\t" << (mixed ? "mixed" : "small") << "\t"
+              << g_allocations - allocBefore << " allocs\t"
+              << elapsed.count() / ops << " ns/op\t(sink " << sink << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t rounds = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    run<Stack<int>>("Stack<int>", rounds, false);
+    run<fixed::Stack<int, 16>>("Stack<int,16>", rounds, false);
+    run<SmallStack<int, 16>>("SmallStack<int,16>", rounds, false);
+
+    run<Stack<int>>("Stack<int>", rounds, true);
+    run<SmallStack<int, 16>>("SmallStack<int,16>", rounds, true);
+}
@@ -0,0 +1,75 @@
+/**
+ * 《AssignedStack存储方式的吞吐量》
+ * 分别以std::deque、std::vector和ContiguousStorage作为AssignedStack的Storage，测试以下四种操作每秒处理的元素数量：
+ *   push：逐个压入N个int
+ *   iterate：从栈底到栈顶遍历并求和
+ *   assign：将AssignedStack<int>赋值给AssignedStack<float>
+ *   pop：逐个弹出N个元素
+ * 用法：bench_storage.exe [N1 N2 ...]，默认N为1K、1M和100M
+ */
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <vector>
+#include "stack.hpp"
+#include "contiguous_storage.hpp"
+
+template<typename F>
+double mops(std::size_t elements, std::size_t repeat, F f){
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < repeat; ++i) f();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(elements) * repeat / elapsed.count();
+}
+
+template<template<typename> class Storage>
+void run(const char *name, std::size_t n){
+    using IStack = AssignedStack<int, Storage<int>>;
+    using FStack = AssignedStack<float, Storage<float>>;
+
+    /* 对于较小的N重复多次，使每项测试处理的元素总数接近 */
+    const std::size_t repeat = (n >= 100000000) ? 1 : 100000000 / n;
+    IStack istack;
+    long long sum = 0;
+
+    double push = mops(n, repeat, [&]{
+        istack = IStack();
+        for(std::size_t i = 0; i < n; ++i) istack.push(static_cast<int>(i));
+    });
+    double iterate = mops(n, repeat, [&]{
+        for(int e : istack) sum += e;
+    });
+    FStack fstack;
+    double assign = mops(n, repeat, [&]{ fstack = istack; });
+    /* pop只测量弹出元素的时间，不包括创建拷贝的时间 */
+    double popUs = 0;
+    for(std::size_t i = 0; i < repeat; ++i){
+        IStack cpy(istack);
+        auto begin = std::chrono::steady_clock::now();
+        while(!cpy.empty()) cpy.pop();
+        popUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    }
+    double pop = static_cast<double>(n) * repeat / popUs;
+
+    std::cout << name << "\t" << n << "\t" << push << "\t" << iterate << "\t" << assign << "\t" << pop
+              << "\t(sum " << sum << ")" << std::endl;
+}
+
+template<typename T>
+using Deque = std::deque<T>;
+template<typename T>
+using Vector = std::vector<T>;
+
+int main(int argc, char *argv[]){
+    std::vector<std::size_t> sizes;
+    for(int i = 1; i < argc; ++i) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if(sizes.empty()) sizes = {1000, 1000000, 100000000};
+
+    std::cout << "storage\tN\tpush(M/s)\titerate(M/s)\tassign(M/s)\tpop(M/s)" << std::endl;
+    for(std::size_t n : sizes){
+        run<Deque>("deque", n);
+        run<Vector>("vector", n);
+        run<ContiguousStorage>("contiguous", n);
+    }
+}
@@ -0,0 +1,261 @@
+#ifndef CONTIGUOUS_STORAGE_HPP
+#define CONTIGUOUS_STORAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《连续存储的双端容器》
+ * AssignedStack最初选择std::deque只是为了使用push_front，但deque将元素分散保存在多个固定大小的块中，每次访问都要先找到元素所在的块。ContiguousStorage<T>
+ * 将所有元素保存在同一段数组中，元素的前后两侧都预留了空闲空间，因此push_back和push_front都是均摊O(1)的，而遍历时则与std::vector一样顺序访问内存。
+ * 它实现了AssignedStack需要的deque接口的子集，可作为AssignedStack的Storage参数使用。
+ * 与标准容器一样，内存通过分配器Alloc获取，元素通过std::allocator_traits<Alloc>构造和析构，因此也可以使用std::pmr::polymorphic_allocator。
+ */
+template<typename T, typename Alloc = std::allocator<T>>
+class ContiguousStorage{
+    using Traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    ContiguousStorage() noexcept(noexcept(Alloc())) = default;
+    explicit ContiguousStorage(const Alloc &alloc) noexcept : m_alloc(alloc){}
+    ContiguousStorage(const ContiguousStorage &other)
+        : ContiguousStorage(other.begin(), other.end(), Traits::select_on_container_copy_construction(other.m_alloc)){}
+    ContiguousStorage(ContiguousStorage &&other) noexcept : m_alloc(other.m_alloc) { swapBuffers(other); }
+    ~ContiguousStorage() { release(); }
+
+    template<typename It>
+    ContiguousStorage(It first, It last, const Alloc &alloc = Alloc()) : m_alloc(alloc) { assign(first, last); }
+
+    ContiguousStorage& operator=(const ContiguousStorage &other){
+        if(this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+
+    /* 分配器不随移动赋值传播并且两者不相等时(例如使用不同memory_resource的polymorphic_allocator)，不能接管other的缓冲区，只能逐个移动元素 */
+    ContiguousStorage& operator=(ContiguousStorage &&other) noexcept(Traits::propagate_on_container_move_assignment::value || Traits::is_always_equal::value){
+        if(this == &other) return *this;
+        if constexpr (Traits::propagate_on_container_move_assignment::value){
+            release();
+            m_alloc = other.m_alloc;
+            swapBuffers(other);
+        }else{
+            if(m_alloc == other.m_alloc){
+                release();
+                swapBuffers(other);
+            }else{
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    iterator begin() noexcept                     { return m_begin; }
+    iterator end() noexcept                        { return m_end; }
+    const_iterator begin() const noexcept  { return m_begin; }
+    const_iterator end() const noexcept     { return m_end; }
+
+    size_type size() const noexcept     { return static_cast<size_type>(m_end - m_begin); }
+    bool empty() const noexcept           { return m_begin == m_end; }
+    T& front()                                   { return *m_begin; }
+    const T& front() const                { return *m_begin; }
+    T& back()                                    { return *(m_end - 1); }
+    const T& back() const                 { return *(m_end - 1); }
+
+    void push_back(const T &e)  { emplace_back(e); }
+    void push_back(T &&e)       { emplace_back(std::move(e)); }
+    void push_front(const T &e) { emplace_front(e); }
+    void push_front(T &&e)      { emplace_front(std::move(e)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args){
+        if(m_end == m_cap){
+            T tmp(std::forward<Args>(args)...);  //args可能引用着容器中的元素，因此需要在扩容前构造新元素
+            makeRoom();
+            Traits::construct(m_alloc, m_end, std::move(tmp));
+        }else{
+            Traits::construct(m_alloc, m_end, std::forward<Args>(args)...);
+        }
+        return *m_end++;
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args){
+        if(m_begin == m_buf){
+            T tmp(std::forward<Args>(args)...);
+            makeRoom();
+            Traits::construct(m_alloc, m_begin - 1, std::move(tmp));
+        }else{
+            Traits::construct(m_alloc, m_begin - 1, std::forward<Args>(args)...);
+        }
+        return *--m_begin;
+    }
+
+    void pop_back()  { Traits::destroy(m_alloc, --m_end); }
+    void pop_front() { Traits::destroy(m_alloc, m_begin++); }
+
+    void clear() noexcept{
+        destroyRange(m_begin, m_end);
+        m_begin = m_end = m_buf;
+    }
+
+    /* 对于前向迭代器，元素数量可以预先得知，因此至多分配一次内存，并且元素总是从缓冲区的起始位置开始保存 */
+    template<typename It>
+    void assign(It first, It last);
+
+    /* 与标准容器相同，分配器只在propagate_on_container_swap为真时交换，否则要求两者的分配器相等 */
+    void swap(ContiguousStorage &other) noexcept{
+        if constexpr (Traits::propagate_on_container_swap::value){
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        swapBuffers(other);
+    }
+
+private:
+    void swapBuffers(ContiguousStorage &other) noexcept{
+        std::swap(m_buf, other.m_buf);
+        std::swap(m_cap, other.m_cap);
+        std::swap(m_begin, other.m_begin);
+        std::swap(m_end, other.m_end);
+    }
+
+    void destroyRange(T *first, T *last) noexcept{
+        for(; first != last; ++first) Traits::destroy(m_alloc, first);
+    }
+
+    /* 在未初始化的内存dest上依次构造[first, last)中的元素，构造失败时析构已构造的元素 */
+    template<typename It>
+    T* constructRange(It first, It last, T *dest){
+        T *cur = dest;
+        try{
+            for(; first != last; ++first, ++cur) Traits::construct(m_alloc, cur, *first);
+        }catch(...){
+            destroyRange(dest, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    /* 某一端没有空闲空间时调用。元素不足缓冲区的一半时，只在原缓冲区内把元素移到中间；否则扩容。只从一端插入、从另一端删除时，
+     * 容量因此不会无限增长。原地移动需要逐个移动构造并析构元素，移动构造可能抛出异常时无法恢复原状，这时总是扩容 */
+    void makeRoom(){
+        if constexpr (std::is_nothrow_move_constructible_v<T>){
+            if(size() * 2 < static_cast<std::size_t>(m_cap - m_buf)){
+                recenter();
+                return;
+            }
+        }
+        grow();
+    }
+
+    /* 扩容后元素被放置在新缓冲区的中间，两侧留出相同的空闲空间，这样无论此后从哪一侧插入，都可以保证均摊O(1) */
+    void grow();
+    void recenter() noexcept;
+    void release() noexcept;
+
+    Alloc m_alloc;
+    T *m_buf = nullptr;     //缓冲区起始位置
+    T *m_cap = nullptr;     //缓冲区结束位置
+    T *m_begin = nullptr;   //第一个元素
+    T *m_end = nullptr;     //最后一个元素的下一个位置
+};
+
+template<typename T, typename Alloc>
+void ContiguousStorage<T, Alloc>::release() noexcept{
+    destroyRange(m_begin, m_end);
+    if(m_buf) Traits::deallocate(m_alloc, m_buf, static_cast<std::size_t>(m_cap - m_buf));
+    m_buf = m_cap = m_begin = m_end = nullptr;
+}
+
+template<typename T, typename Alloc>
+void ContiguousStorage<T, Alloc>::grow(){
+    const std::size_t oldSize = size();
+    const std::size_t oldCapacity = static_cast<std::size_t>(m_cap - m_buf);
+    const std::size_t newCapacity = std::max<std::size_t>(16, oldCapacity * 2);
+    const std::size_t offset = (newCapacity - oldSize) / 2;
+
+    T *buf = Traits::allocate(m_alloc, newCapacity);
+    try{
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>){
+            constructRange(std::make_move_iterator(m_begin), std::make_move_iterator(m_end), buf + offset);
+        }else{
+            constructRange(m_begin, m_end, buf + offset);
+        }
+    }catch(...){
+        Traits::deallocate(m_alloc, buf, newCapacity);
+        throw;
+    }
+
+    release();
+    m_buf = buf;
+    m_cap = buf + newCapacity;
+    m_begin = buf + offset;
+    m_end = m_begin + oldSize;
+}
+
+/* 目标位置与原位置可能重叠：向前移动时从第一个元素开始，向后移动时从最后一个元素开始，每个元素移动后立即析构，
+ * 这样每次构造的目标位置要么在原范围之外，要么是已经析构的元素 */
+template<typename T, typename Alloc>
+void ContiguousStorage<T, Alloc>::recenter() noexcept{
+    const std::size_t n = size();
+    T *first = m_buf + (static_cast<std::size_t>(m_cap - m_buf) - n) / 2;
+    if(first < m_begin){
+        for(std::size_t i = 0; i < n; ++i){
+            Traits::construct(m_alloc, first + i, std::move(m_begin[i]));
+            Traits::destroy(m_alloc, m_begin + i);
+        }
+    }else if(first > m_begin){
+        for(std::size_t i = n; i > 0; --i){
+            Traits::construct(m_alloc, first + i - 1, std::move(m_begin[i - 1]));
+            Traits::destroy(m_alloc, m_begin + i - 1);
+        }
+    }
+    m_begin = first;
+    m_end = first + n;
+}
+
+template<typename T, typename Alloc>
+  template<typename It>
+void ContiguousStorage<T, Alloc>::assign(It first, It last){
+    using Category = typename std::iterator_traits<It>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>){
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if(n > static_cast<std::size_t>(m_cap - m_buf)){
+            ContiguousStorage tmp(m_alloc);
+            tmp.m_buf = Traits::allocate(tmp.m_alloc, n);
+            tmp.m_cap = tmp.m_buf + n;
+            tmp.m_begin = tmp.m_end = tmp.m_buf;
+            tmp.m_end = tmp.constructRange(first, last, tmp.m_buf);
+            swapBuffers(tmp);
+        }else{
+            clear();
+            m_end = constructRange(first, last, m_buf);
+        }
+    }else{
+        clear();
+        for(; first != last; ++first) emplace_back(*first);
+    }
+}
+
+/* 使用std::pmr::memory_resource分配内存的ContiguousStorage，可以作为PmrAssignedStack的Storage参数 */
+template<typename T>
+using PmrContiguousStorage = ContiguousStorage<T, std::pmr::polymorphic_allocator<T>>;
+
+#endif
\ No newline at end of file
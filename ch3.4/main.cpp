@@ -9,21 +9,10 @@
  *   进行特例化。[例3]
  */
 #include <iostream>
-#include <deque>
-#include <vector>
+#include "stack.hpp"
 
 //===============例1===============
-template<typename T>
-class Stack{
-public:
-    void push(const T &e){ m_cont.push_back(e); }
-    void pop()                   { m_cont.pop_back(); }
-    T      top()                    { return m_cont.back(); }
-    bool empty()               { return m_cont.empty(); }
-
-private:
-    std::vector<T> m_cont;
-};
+/* Stack的定义见stack.hpp */
 
 void func1(){
     Stack<int> istack1, istack2;
@@ -34,41 +23,7 @@ void func1(){
 }
 
 //===============例2===============
-template<typename T>
-class AssignedStack{
-public:
-    void push(const T &e){ m_cont.push_back(e); }
-    void pop()                   { m_cont.pop_back(); }
-    T      top()                    { return m_cont.back(); }
-    bool empty()               { return m_cont.empty(); }
-
-    /* 将赋值操作符声明为了一个模板，新增了模板参数T2，使得参数other可以接受与当前AssignedStack的元素类型不同的另一个AssignedStack */
-    template<typename T2>
-    AssignedStack& operator=(const AssignedStack<T2> &other);
-
-private:
-    /* 由于我们赋值时会从栈顶弹出元素，为了确保元素原本的顺序，我们需要把每个元素都插入列表头部，因此此处将vector替换为了提供了push_front函数的deque */
-    std::deque<T> m_cont;
-};
-
-/**
- * 1.当我们选择将成员模板定义在模板类的外部时，需要同时声明类模板和成员模板的模板参数，此处我们将内部的模板参数进行了缩进以作区分。
- * 2.可以看到，我们为operator=的参数“AssignedStack<T2> &other“指定了另一个模板参数T2，这样一来other就可以接受与当前AssignedStack元素类型不同的
- *   AssignedStack。随后我们就可以将other的元素依次push到当前的AssignedStack，前提是T和T2之间存在类型转换关系。
- */
-template<typename T>
-  template<typename T2>
-inline AssignedStack<T>& AssignedStack<T>::operator=(const AssignedStack<T2> &other){
-    AssignedStack<T2> cpy(other);  //通过创建other的拷贝，我们可以避免自赋值问题；并且由于other是const的，所以不能调用它的非const成员函数，而拷贝则没有这个问题
-    m_cont.clear();
-
-    while(!cpy.empty()){
-        m_cont.push_front(cpy.top()); //前提是T2可以隐式转换为T
-        cpy.pop();
-    }
-
-    return *this;
-}
+/* AssignedStack的定义见stack.hpp */
 
 void func2(){
     AssignedStack<int> istack;
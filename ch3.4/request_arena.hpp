@@ -0,0 +1,46 @@
+#ifndef REQUEST_ARENA_HPP
+#define REQUEST_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * 《按请求整体释放的内存池》
+ * 在按请求处理的场景中，每个请求都会创建并丢弃大量的Stack和AssignedStack，每个栈的每次扩容都是一次malloc/free。RequestArena将两种std::pmr内存资源
+ * 组合在一起，为同一个请求中的所有栈提供内存：
+ *   1.resource()返回一个monotonic_buffer_resource，它从一块预先分配的初始缓冲区开始顺序分配，缓冲区用完后再向上游(默认为new/delete)申请更大的块。
+ *     单次分配只是移动一个指针，释放则什么也不做，因此被释放的内存在请求结束前不会被再次利用。对于栈这种按倍数扩容的对象，被丢弃的旧缓冲区总量不超过
+ *     最终容量，这通常是可以接受的，也是最快的选择。
+ *   2.pool()返回一个建立在前者之上的unsynchronized_pool_resource，它按照大小将内存分为若干个尺寸类别，被释放的块会进入对应类别的空闲链表并被此后
+ *     相同大小的分配复用。当一个请求中反复创建和销毁对象，使得单调分配的内存占用不可接受时，应当使用pool()，代价是每次分配和释放都需要查找尺寸类别。
+ *   3.reset()依次释放池和单调缓冲区，单调缓冲区回到初始缓冲区的起点，一个请求的所有内存都在这一步一起回收，而初始缓冲区本身会被下一个请求继续使用。
+ *     调用reset()之前必须确保所有使用该RequestArena的对象都已经销毁，否则它们将持有悬空指针。
+ * RequestArena不是线程安全的，每个处理请求的线程应当拥有自己的RequestArena。
+ */
+class RequestArena{
+public:
+    explicit RequestArena(std::size_t initialBytes = 64 * 1024)
+        : m_initial(new std::byte[initialBytes]),
+          m_monotonic(m_initial.get(), initialBytes),
+          m_pool(&m_monotonic){
+    }
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator= (const RequestArena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &m_monotonic; }
+    std::pmr::memory_resource* pool() noexcept     { return &m_pool; }
+
+    void reset(){
+        m_pool.release();
+        m_monotonic.release();
+    }
+
+private:
+    std::unique_ptr<std::byte[]> m_initial;
+    std::pmr::monotonic_buffer_resource m_monotonic;
+    std::pmr::unsynchronized_pool_resource m_pool;
+};
+
+#endif
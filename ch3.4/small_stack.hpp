@@ -0,0 +1,186 @@
+#ifndef SMALL_STACK_HPP
+#define SMALL_STACK_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《小缓冲区优化的Stack》
+ * stack.hpp中的Stack<T>总是通过std::vector在堆上保存元素，即使只压入了一个元素也需要一次内存分配；而ch2.1中的Stack<T, Size>虽然不分配内存，但在
+ * 元素数量达到Size后会静默地丢弃后续压入的元素。SmallStack<T, InlineN>结合了两者：前InlineN个元素保存在对象内部的缓冲区中，只有当元素数量超出
+ * InlineN时，才将元素迁移到堆上的缓冲区，并且此后每次扩容都将容量翻倍。
+ * 1.内部缓冲区是一段未初始化的、按T对齐的字节数组，元素通过placement new在其中构造，因此T不需要提供默认构造函数。
+ * 2.emplace是一个成员函数模板，它将参数完美转发给T的构造函数，直接在栈顶的位置构造元素；push(T&&)则借助emplace移动而非拷贝元素。
+ */
+template<typename T, std::size_t InlineN = 16>
+class SmallStack{
+    static_assert(InlineN > 0, "InlineN must be greater than 0");
+
+public:
+    SmallStack() noexcept : m_data(inlineData()), m_size(0), m_capacity(InlineN){}
+    SmallStack(const SmallStack &other);
+    SmallStack(SmallStack &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    SmallStack& operator=(const SmallStack &other);
+    SmallStack& operator=(SmallStack &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    ~SmallStack();
+
+    void push(const T &e){ emplace(e); }
+    void push(T &&e)     { emplace(std::move(e)); }
+
+    template<typename... Args>
+    T& emplace(Args&&... args);
+
+    void pop()                        { m_data[--m_size].~T(); }
+    T& top()                           { return m_data[m_size - 1]; }
+    const T& top() const         { return m_data[m_size - 1]; }
+    bool empty() const            { return m_size == 0; }
+    std::size_t size() const      { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    bool isInline() const          { return m_data == inlineData(); }
+    void clear();
+
+private:
+    T* inlineData() noexcept                  { return reinterpret_cast<T*>(m_inline); }
+    const T* inlineData() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+    template<typename... Args>
+    T& emplaceGrow(Args&&... args);
+    void stealFrom(SmallStack &other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    void release() noexcept;
+
+    /* 将[first, first + n)中的元素转移到dest，如果T的移动构造函数不会抛出异常或者T无法拷贝，则移动元素，否则拷贝元素 */
+    static void relocate(T *first, std::size_t n, T *dest);
+
+    alignas(T) unsigned char m_inline[InlineN * sizeof(T)];
+    T *m_data;
+    std::size_t m_size;
+    std::size_t m_capacity;
+};
+
+template<typename T, std::size_t InlineN>
+void SmallStack<T,InlineN>::relocate(T *first, std::size_t n, T *dest){
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>){
+        std::uninitialized_move(first, first + n, dest);
+    }else{
+        std::uninitialized_copy(first, first + n, dest);
+    }
+}
+
+template<typename T, std::size_t InlineN>
+SmallStack<T,InlineN>::SmallStack(const SmallStack &other) : SmallStack(){
+    if(other.m_size > InlineN){
+        m_data = std::allocator<T>().allocate(other.m_size);
+        m_capacity = other.m_size;
+    }
+    std::uninitialized_copy(other.m_data, other.m_data + other.m_size, m_data);
+    m_size = other.m_size;
+}
+
+template<typename T, std::size_t InlineN>
+SmallStack<T,InlineN>::SmallStack(SmallStack &&other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallStack(){
+    stealFrom(other);
+}
+
+template<typename T, std::size_t InlineN>
+SmallStack<T,InlineN>& SmallStack<T,InlineN>::operator=(const SmallStack &other){
+    if(this != &other){
+        SmallStack cpy(other);
+        release();
+        stealFrom(cpy);
+    }
+    return *this;
+}
+
+template<typename T, std::size_t InlineN>
+SmallStack<T,InlineN>& SmallStack<T,InlineN>::operator=(SmallStack &&other) noexcept(std::is_nothrow_move_constructible_v<T>){
+    if(this != &other){
+        release();
+        stealFrom(other);
+    }
+    return *this;
+}
+
+template<typename T, std::size_t InlineN>
+SmallStack<T,InlineN>::~SmallStack(){
+    release();
+}
+
+/* 要求*this处于空的、使用内部缓冲区的状态。如果other的元素在堆上，则直接接管other的缓冲区；否则只能逐个移动内部缓冲区中的元素 */
+template<typename T, std::size_t InlineN>
+void SmallStack<T,InlineN>::stealFrom(SmallStack &other) noexcept(std::is_nothrow_move_constructible_v<T>){
+    if(other.isInline()){
+        std::uninitialized_move(other.m_data, other.m_data + other.m_size, m_data);
+        m_size = other.m_size;
+        other.clear();
+    }else{
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        other.m_data = other.inlineData();
+        other.m_size = 0;
+        other.m_capacity = InlineN;
+    }
+}
+
+template<typename T, std::size_t InlineN>
+void SmallStack<T,InlineN>::clear(){
+    std::destroy(m_data, m_data + m_size);
+    m_size = 0;
+}
+
+template<typename T, std::size_t InlineN>
+void SmallStack<T,InlineN>::release() noexcept{
+    clear();
+    if(!isInline()){
+        std::allocator<T>().deallocate(m_data, m_capacity);
+        m_data = inlineData();
+        m_capacity = InlineN;
+    }
+}
+
+template<typename T, std::size_t InlineN>
+  template<typename... Args>
+T& SmallStack<T,InlineN>::emplace(Args&&... args){
+    if(m_size == m_capacity){
+        return emplaceGrow(std::forward<Args>(args)...);
+    }
+
+    T *e = ::new(static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *e;
+}
+
+/**
+ * 扩容时需要先在新缓冲区中构造新元素，然后再转移旧元素，因为args可能引用着当前栈中的某个元素(例如s.push(s.top()))，如果先转移旧元素，
+ * args引用的对象就可能已经被移走或者销毁。
+ */
+template<typename T, std::size_t InlineN>
+  template<typename... Args>
+T& SmallStack<T,InlineN>::emplaceGrow(Args&&... args){
+    std::allocator<T> alloc;
+    const std::size_t newCapacity = m_capacity * 2;
+    T *newData = alloc.allocate(newCapacity);
+
+    T *e = nullptr;
+    try{
+        e = ::new(static_cast<void*>(newData + m_size)) T(std::forward<Args>(args)...);
+        relocate(m_data, m_size, newData);
+    }catch(...){
+        if(e) e->~T();
+        alloc.deallocate(newData, newCapacity);
+        throw;
+    }
+
+    std::destroy(m_data, m_data + m_size);
+    if(!isInline()) alloc.deallocate(m_data, m_capacity);
+
+    m_data = newData;
+    m_capacity = newCapacity;
+    ++m_size;
+    return *e;
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef ASSIGNED_STACK_HPP
+#define ASSIGNED_STACK_HPP
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//===============例1===============
+/**
+ * Alloc是底层std::vector使用的分配器，默认为std::allocator<T>。Stack定义了allocator_type并提供了以分配器为最后一个参数的构造函数，因此它遵循“使用分配器构造”
+ * (uses-allocator construction)的约定：当Stack作为std::pmr::vector等容器的元素时，容器会自动将自己的memory_resource传递给每个Stack。
+ */
+template<typename T, typename Alloc = std::allocator<T>>
+class Stack{
+public:
+    using allocator_type = Alloc;
+
+    Stack() = default;
+    explicit Stack(const Alloc &alloc) : m_cont(alloc){ }
+    Stack(const Stack &other, const Alloc &alloc) : m_cont(other.m_cont, alloc){ }
+    Stack(Stack &&other, const Alloc &alloc) : m_cont(std::move(other.m_cont), alloc){ }
+    Stack(const Stack&) = default;
+    Stack(Stack&&) = default;
+    Stack& operator= (const Stack&) = default;
+    Stack& operator= (Stack&&) = default;
+
+    void push(const T &e){ m_cont.push_back(e); }
+    void pop()                   { m_cont.pop_back(); }
+    T      top()                    { return m_cont.back(); }
+    bool empty()               { return m_cont.empty(); }
+
+private:
+    std::vector<T, Alloc> m_cont;
+};
+
+//===============例2===============
+/**
+ * 存储方式作为模板参数Storage，默认仍使用std::deque<T>。任何提供了push_back、pop_back、back、empty、size、clear、begin/end、assign以及迭代器区间
+ * 构造函数的容器都可以用作Storage，例如std::vector<T>或contiguous_storage.hpp中的ContiguousStorage<T>。
+ */
+template<typename T, typename Storage = std::deque<T>>
+class AssignedStack{
+public:
+    AssignedStack() = default;
+
+    /**
+     * 使用指定的分配器构造存储空间，例如std::pmr::deque<T>可以由std::pmr::memory_resource*构造。只接受Storage的分配器(std::uses_allocator成立)，
+     * 否则AssignedStack<int, std::vector<int>> s(5)会构造出5个元素，传入一个Storage也会变成拷贝。
+     */
+    template<typename A, typename = std::enable_if_t<std::uses_allocator_v<Storage, A> && std::is_constructible_v<Storage, const A&>>>
+    explicit AssignedStack(const A &alloc) : m_cont(alloc){ }
+
+    /**
+     * 转换构造函数同样是成员模板，它让我们可以直接用元素类型不同的AssignedStack初始化当前AssignedStack。注意成员模板永远不会被当作拷贝/移动构造函数，
+     * 因此当T2、S2与T、Storage都相同时，编译器仍会选择隐式生成的拷贝/移动构造函数，其中移动构造函数会直接接管other的存储空间，不会逐个转移元素。
+     */
+    template<typename T2, typename S2>
+    AssignedStack(const AssignedStack<T2, S2> &other);
+    template<typename T2, typename S2>
+    AssignedStack(AssignedStack<T2, S2> &&other);
+
+    void push(const T &e){ m_cont.push_back(e); }
+    void pop()                   { m_cont.pop_back(); }
+    T      top()                    { return m_cont.back(); }
+    bool empty()               { return m_cont.empty(); }
+    std::size_t size() const { return m_cont.size(); }
+
+    /* 按照从栈底到栈顶的顺序遍历元素 */
+    auto begin() const { return m_cont.begin(); }
+    auto end() const    { return m_cont.end(); }
+
+    /* 将赋值操作符声明为了一个模板，新增了模板参数T2，使得参数other可以接受与当前AssignedStack的元素类型不同的另一个AssignedStack */
+    template<typename T2, typename S2>
+    AssignedStack& operator=(const AssignedStack<T2, S2> &other);
+
+    /* 右值版本，other的元素将被移动而非拷贝到当前AssignedStack。与构造函数一样，类型完全相同时将选择隐式生成的移动赋值操作符 */
+    template<typename T2, typename S2>
+    AssignedStack& operator=(AssignedStack<T2, S2> &&other);
+
+private:
+    /* AssignedStack<T>和AssignedStack<T2>是两个不同的类型，为了直接访问other的m_cont，需要将AssignedStack的所有实例声明为友元 */
+    template<typename, typename> friend class AssignedStack;
+
+    /**
+     * 最初的operator=通过从栈顶逐个弹出元素来读取other，为了保持元素原本的顺序，需要将每个元素都插入列表头部，因此这里使用了提供push_front的deque。
+     * 现在operator=直接按从栈底到栈顶的顺序读取other的存储空间，已不再需要push_front，因此存储方式可以通过Storage自由选择。
+     */
+    Storage m_cont;
+};
+
+/**
+ * 1.当我们选择将成员模板定义在模板类的外部时，需要同时声明类模板和成员模板的模板参数，此处我们将内部的模板参数进行了缩进以作区分。
+ * 2.可以看到，我们为operator=的参数“AssignedStack<T2> &other“指定了另一个模板参数T2，这样一来other就可以接受与当前AssignedStack元素类型不同的
+ *   AssignedStack。随后我们就可以将other的元素依次保存到当前的AssignedStack，前提是T和T2之间存在类型转换关系。另一个模板参数S2则使other的存储方式也可以与当前AssignedStack不同。
+ * 3.只有当other的类型与当前AssignedStack不同时才会调用该成员模板，此时*this和other必然是两个不同的对象，所以不存在自赋值问题，因此无需像最初的版本那样先创建other的拷贝再逐个top()/pop()，
+ *   只需对other的存储空间遍历一次，每个元素只转换一次。
+ */
+template<typename T, typename Storage>
+  template<typename T2, typename S2>
+inline AssignedStack<T, Storage>::AssignedStack(const AssignedStack<T2, S2> &other)
+    : m_cont(other.m_cont.begin(), other.m_cont.end()){  //前提是T2可以隐式转换为T
+}
+
+template<typename T, typename Storage>
+  template<typename T2, typename S2>
+inline AssignedStack<T, Storage>::AssignedStack(AssignedStack<T2, S2> &&other)
+    : m_cont(std::make_move_iterator(other.m_cont.begin()), std::make_move_iterator(other.m_cont.end())){
+    other.m_cont.clear();
+}
+
+template<typename T, typename Storage>
+  template<typename T2, typename S2>
+inline AssignedStack<T, Storage>& AssignedStack<T, Storage>::operator=(const AssignedStack<T2, S2> &other){
+    m_cont.assign(other.m_cont.begin(), other.m_cont.end());  //前提是T2可以隐式转换为T
+    return *this;
+}
+
+template<typename T, typename Storage>
+  template<typename T2, typename S2>
+inline AssignedStack<T, Storage>& AssignedStack<T, Storage>::operator=(AssignedStack<T2, S2> &&other){
+    m_cont.assign(std::make_move_iterator(other.m_cont.begin()), std::make_move_iterator(other.m_cont.end()));
+    other.m_cont.clear();
+    return *this;
+}
+
+//===============使用std::pmr的别名===============
+/**
+ * 以下别名使Stack和AssignedStack从std::pmr::memory_resource分配内存，它们都可以直接由一个memory_resource*构造，例如：
+ *   PmrStack<int> s(arena.resource());
+ * 配合request_arena.hpp中的RequestArena，同一个请求中创建的所有栈可以在请求结束时通过一次reset整体释放。
+ */
+template<typename T>
+using PmrStack = Stack<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T, typename Storage = std::pmr::deque<T>>
+using PmrAssignedStack = AssignedStack<T, Storage>;
+
+#endif
\ No newline at end of file
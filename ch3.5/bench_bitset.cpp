@@ -0,0 +1,139 @@
+/**
+ * 《std::bitset、std::vector<bool>与BitSet》
+ * 位集合的长度为2^20，分别比较：按位与/或/异或/andNot、count、以1%和50%的密度遍历所有置位、rank(i)和select(k)的随机查询，以及以二进制格式输出到
+ * 一个丢弃所有数据的输出流。std::bitset逐位调用test遍历置位，rank通过对移位后的副本调用count实现，输出使用to_string；std::vector<bool>的rank
+ * 和select使用std::count和逐位扫描。
+ * 用法：bench_bitset.exe [重复次数]
+ */
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <streambuf>
+#include <vector>
+#include "bitset.hpp"
+
+constexpr std::size_t N = 1 << 20;
+
+/* 丢弃所有输出的流缓冲区，使计时只包括格式化本身 */
+class NullBuffer : public std::streambuf{
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+};
+
+template<typename F>
+double timeUs(std::size_t reps, F &&f){
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t r = 0; r < reps; ++r) f();
+    std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - begin;
+    return us.count() / reps;
+}
+
+void report(const char *op, double stdBitset, double vectorBool, double bitSet, double dynamic){
+    std::cout << op << "\t" << stdBitset << "\t" << vectorBool << "\t" << bitSet << "\t" << dynamic << std::endl;
+}
+
+struct Sets{
+    std::unique_ptr<std::bitset<N>> sb = std::make_unique<std::bitset<N>>();
+    std::vector<bool> vb = std::vector<bool>(N);
+    std::unique_ptr<BitSet<N>> bs = std::make_unique<BitSet<N>>();
+    DynamicBitSet ds = DynamicBitSet(N);
+
+    Sets(double density, unsigned seed){
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution coin(density);
+        for(std::size_t i = 0; i < N; ++i){
+            if(coin(rng)){
+                sb->set(i);
+                vb[i] = true;
+                bs->set(i);
+                ds.set(i);
+            }
+        }
+    }
+};
+
+int main(int argc, char *argv[]){
+    std::size_t reps = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+    Sets a(0.5, 1), b(0.5, 2), sparse(0.01, 3);
+    std::size_t sink = 0;
+
+    std::cout << "op(us/op)\tstd::bitset\tvector<bool>\tBitSet\tDynamicBitSet" << std::endl;
+
+    auto combine = [&](const char *op, auto f){
+        double t0 = timeUs(reps, [&]{ f(*a.sb, *b.sb); sink += (*a.sb)[7]; });
+        double t1 = timeUs(reps, [&]{
+            for(std::size_t i = 0; i < N; ++i) a.vb[i] = f(bool(a.vb[i]), bool(b.vb[i]));
+            sink += a.vb[7];
+        });
+        double t2 = timeUs(reps, [&]{ f(*a.bs, *b.bs); sink += a.bs->test(7); });
+        double t3 = timeUs(reps, [&]{ f(a.ds, b.ds); sink += a.ds.test(7); });
+        report(op, t0, t1, t2, t3);
+    };
+
+    combine("and", [](auto &&x, const auto &y){ if constexpr (std::is_same_v<std::decay_t<decltype(x)>, bool>) return x && y; else { x &= y; return true; } });
+    combine("or", [](auto &&x, const auto &y){ if constexpr (std::is_same_v<std::decay_t<decltype(x)>, bool>) return x || y; else { x |= y; return true; } });
+    combine("xor", [](auto &&x, const auto &y){ if constexpr (std::is_same_v<std::decay_t<decltype(x)>, bool>) return x != y; else { x ^= y; return true; } });
+    combine("andnot", [](auto &&x, const auto &y){
+        if constexpr (std::is_same_v<std::decay_t<decltype(x)>, bool>) return x && !y;
+        else if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::bitset<N>>) { x &= ~y; return true; }
+        else { x.andNot(y); return true; }
+    });
+
+    report("count",
+           timeUs(reps, [&]{ sink += b.sb->count(); }),
+           timeUs(reps, [&]{ sink += static_cast<std::size_t>(std::count(b.vb.begin(), b.vb.end(), true)); }),
+           timeUs(reps, [&]{ sink += b.bs->count(); }),
+           timeUs(reps, [&]{ sink += b.ds.count(); }));
+
+    auto iterate = [&](const char *op, Sets &s){
+        report(op,
+               timeUs(reps, [&]{ for(std::size_t i = 0; i < N; ++i) if(s.sb->test(i)) sink += i; }),
+               timeUs(reps, [&]{ for(std::size_t i = 0; i < N; ++i) if(s.vb[i]) sink += i; }),
+               timeUs(reps, [&]{ s.bs->forEachSetBit([&](std::size_t i){ sink += i; }); }),
+               timeUs(reps, [&]{ s.ds.forEachSetBit([&](std::size_t i){ sink += i; }); }));
+    };
+    iterate("iterate 1%", sparse);
+    iterate("iterate 50%", b);
+
+    /* 每次查询一个随机位置 */
+    std::mt19937 rng(4);
+    std::vector<std::size_t> positions(reps);
+    for(std::size_t &p : positions) p = rng() % N;
+    std::size_t q = 0;
+    report("rank",
+           timeUs(reps, [&]{ std::size_t p = positions[q++ % reps]; sink += (*b.sb << (N - p)).count(); }),
+           timeUs(reps, [&]{ std::size_t p = positions[q++ % reps]; sink += static_cast<std::size_t>(std::count(b.vb.begin(), b.vb.begin() + p, true)); }),
+           timeUs(reps, [&]{ sink += b.bs->rank(positions[q++ % reps]); }),
+           timeUs(reps, [&]{ sink += b.ds.rank(positions[q++ % reps]); }));
+
+    const std::size_t total = b.bs->count();
+    report("select",
+           timeUs(reps, [&]{
+               std::size_t k = positions[q++ % reps] % total, i = 0;
+               for(; i < N; ++i) if(b.sb->test(i) && k-- == 0) break;
+               sink += i;
+           }),
+           timeUs(reps, [&]{
+               std::size_t k = positions[q++ % reps] % total, i = 0;
+               for(; i < N; ++i) if(b.vb[i] && k-- == 0) break;
+               sink += i;
+           }),
+           timeUs(reps, [&]{ sink += b.bs->select(positions[q++ % reps] % total); }),
+           timeUs(reps, [&]{ sink += b.ds.select(positions[q++ % reps] % total); }));
+
+    NullBuffer null;
+    std::ostream os(&null);
+    report("binary",
+           timeUs(reps, [&]{ os << b.sb->to_string(); }),
+           timeUs(reps, [&]{ for(std::size_t i = N; i-- > 0;) os.put(b.vb[i] ? '1' : '0'); }),
+           timeUs(reps, [&]{ b.bs->writeBinary(os); }),
+           timeUs(reps, [&]{ b.ds.writeBinary(os); }));
+
+    std::cout << "(check " << sink << ")" << std::endl;
+}
@@ -0,0 +1,396 @@
+#ifndef BITSET_HPP
+#define BITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITSET_X86 1
+#endif
+
+/**
+ * 《按字并行的位集合》
+ * main.cpp中的printBitset只能通过.template to_string<...>()先构造一个std::string再输出，而std::bitset本身也不提供遍历、rank/select以及快速查找置位的
+ * 手段，只能逐位调用test。BitSet<N>和DynamicBitSet将位保存在64位整数数组中，所有操作都以字为单位进行：
+ *   1.&=、|=、^=以及andNot(a &= ~b)在CPU支持AVX2时每条指令处理256位，否则每次处理一个64位字，实现在第一次调用时根据CPU支持的指令集选定。
+ *   2.count和rank(i)(即[0, i)中置位的个数)在支持AVX2时使用基于pshufb查表的向量popcount，在支持popcnt指令时使用popcnt，否则使用普通的位运算。
+ *   3.select(k)返回第k个(从0开始)置位的下标，不存在时返回size()；forEachSetBit(f)通过tzcnt逐个取出每个字中最低的置位，跳过全0的字，
+ *     其代价与置位的数量而不是位的总数成正比。
+ *   4.writeBinary和writeHex以高位在前的顺序(与to_string相同)将位写入输出流，每次写入一段固定大小的栈上缓冲区，不构造std::string。
+ * BitSet<N>的长度在编译时确定，DynamicBitSet的长度在运行时确定，两者通过BitSetBase共享同一套实现。超出长度的位总是保持为0，因此count等操作无需屏蔽最后一个字。
+ */
+
+//===============字级别的内核===============
+enum class BitOp{ And, Or, Xor, AndNot };
+
+using CombineKernel = void (*)(std::uint64_t*, const std::uint64_t*, std::size_t);
+using PopcountKernel = std::size_t (*)(const std::uint64_t*, std::size_t);
+
+inline std::size_t popcountWord(std::uint64_t w){
+    return static_cast<std::size_t>(__builtin_popcountll(w));
+}
+
+template<BitOp Op>
+inline std::uint64_t combineWord(std::uint64_t a, std::uint64_t b){
+    if constexpr (Op == BitOp::And) return a & b;
+    else if constexpr (Op == BitOp::Or) return a | b;
+    else if constexpr (Op == BitOp::Xor) return a ^ b;
+    else return a & ~b;
+}
+
+template<BitOp Op>
+void combineScalar(std::uint64_t *dest, const std::uint64_t *src, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i) dest[i] = combineWord<Op>(dest[i], src[i]);
+}
+
+inline std::size_t popcountScalar(const std::uint64_t *words, std::size_t n){
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < n; ++i) count += popcountWord(words[i]);
+    return count;
+}
+
+#ifdef BITSET_X86
+#define BITSET_POPCNT_TARGET __attribute__((target("popcnt")))
+#define BITSET_AVX2_TARGET __attribute__((target("avx2,popcnt")))
+
+BITSET_POPCNT_TARGET inline std::size_t popcountPopcnt(const std::uint64_t *words, std::size_t n){
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < n; ++i) count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    return count;
+}
+
+template<BitOp Op>
+BITSET_AVX2_TARGET __m256i combineAvx2Vec(__m256i a, __m256i b){
+    if constexpr (Op == BitOp::And) return _mm256_and_si256(a, b);
+    else if constexpr (Op == BitOp::Or) return _mm256_or_si256(a, b);
+    else if constexpr (Op == BitOp::Xor) return _mm256_xor_si256(a, b);
+    else return _mm256_andnot_si256(b, a);     //_mm256_andnot_si256(x, y)计算~x & y
+}
+
+template<BitOp Op>
+BITSET_AVX2_TARGET void combineAvx2(std::uint64_t *dest, const std::uint64_t *src, std::size_t n){
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8){
+        __m256i *d = reinterpret_cast<__m256i*>(dest + i);
+        const __m256i *s = reinterpret_cast<const __m256i*>(src + i);
+        const __m256i r0 = combineAvx2Vec<Op>(_mm256_loadu_si256(d), _mm256_loadu_si256(s));
+        const __m256i r1 = combineAvx2Vec<Op>(_mm256_loadu_si256(d + 1), _mm256_loadu_si256(s + 1));
+        _mm256_storeu_si256(d, r0);
+        _mm256_storeu_si256(d + 1, r1);
+    }
+    for(; i < n; ++i) dest[i] = combineWord<Op>(dest[i], src[i]);
+}
+
+/**
+ * 将每个字节拆分为高低两个4位，通过pshufb在16项的表中查出各自的置位数量，再由sad_epu8将每8个字节的结果相加为一个64位整数。
+ * 每个字节的计数最大为8，累加不超过31次就不会溢出，因此每处理31个向量就归约一次。
+ */
+BITSET_AVX2_TARGET inline std::size_t popcountAvx2(const std::uint64_t *words, std::size_t n){
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    while(i + 4 <= n){
+        __m256i bytes = _mm256_setzero_si256();
+        for(int k = 0; k < 31 && i + 4 <= n; ++k, i += 4){
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+            const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(lo, hi));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    std::size_t count = static_cast<std::size_t>(_mm256_extract_epi64(total, 0)) + static_cast<std::size_t>(_mm256_extract_epi64(total, 1))
+                      + static_cast<std::size_t>(_mm256_extract_epi64(total, 2)) + static_cast<std::size_t>(_mm256_extract_epi64(total, 3));
+    for(; i < n; ++i) count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    return count;
+}
+
+#undef BITSET_POPCNT_TARGET
+#undef BITSET_AVX2_TARGET
+#endif
+
+struct BitSetCpu{
+    bool avx2 = false;
+    bool popcnt = false;
+};
+
+inline BitSetCpu detectBitSetCpu(){
+    BitSetCpu cpu;
+#ifdef BITSET_X86
+    __builtin_cpu_init();
+    cpu.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    cpu.popcnt = __builtin_cpu_supports("popcnt");
+#endif
+    return cpu;
+}
+
+inline const BitSetCpu& bitSetCpu(){
+    static const BitSetCpu cpu = detectBitSetCpu();
+    return cpu;
+}
+
+template<BitOp Op>
+CombineKernel selectCombineKernel(){
+#ifdef BITSET_X86
+    if(bitSetCpu().avx2) return &combineAvx2<Op>;
+#endif
+    return &combineScalar<Op>;
+}
+
+inline PopcountKernel selectPopcountKernel(){
+#ifdef BITSET_X86
+    if(bitSetCpu().avx2) return &popcountAvx2;
+    if(bitSetCpu().popcnt) return &popcountPopcnt;
+#endif
+    return &popcountScalar;
+}
+
+template<BitOp Op>
+void combineWords(std::uint64_t *dest, const std::uint64_t *src, std::size_t n){
+    static const CombineKernel kernel = selectCombineKernel<Op>();
+    kernel(dest, src, n);
+}
+
+inline std::size_t popcountWords(const std::uint64_t *words, std::size_t n){
+    static const PopcountKernel kernel = selectPopcountKernel();
+    return kernel(words, n);
+}
+
+/* 返回w中第k个(从0开始)置位的下标，要求k < popcount(w) */
+inline unsigned selectInWord(std::uint64_t w, std::size_t k){
+    for(; k > 0; --k) w &= w - 1;
+    return static_cast<unsigned>(__builtin_ctzll(w));
+}
+
+//===============BitSetBase===============
+/**
+ * Derived需要提供words()、wordCount()和size()，其中words()返回的数组中超出size()的位必须为0。
+ */
+template<typename Derived>
+class BitSetBase{
+public:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    bool test(std::size_t i) const { return (words()[i / WORD_BITS] >> (i % WORD_BITS)) & 1; }
+    bool operator[] (std::size_t i) const { return test(i); }
+
+    Derived& set(std::size_t i, bool value = true){
+        const std::uint64_t bit = std::uint64_t{1} << (i % WORD_BITS);
+        std::uint64_t &w = words()[i / WORD_BITS];
+        w = value ? (w | bit) : (w & ~bit);
+        return self();
+    }
+
+    Derived& reset(std::size_t i) { return set(i, false); }
+
+    Derived& flip(std::size_t i){
+        words()[i / WORD_BITS] ^= std::uint64_t{1} << (i % WORD_BITS);
+        return self();
+    }
+
+    Derived& set(){
+        std::memset(words(), 0xff, wordCount() * sizeof(std::uint64_t));
+        clearPadding();
+        return self();
+    }
+
+    Derived& reset(){
+        std::memset(words(), 0, wordCount() * sizeof(std::uint64_t));
+        return self();
+    }
+
+    Derived& flip(){
+        for(std::size_t i = 0; i < wordCount(); ++i) words()[i] = ~words()[i];
+        clearPadding();
+        return self();
+    }
+
+    std::size_t count() const { return popcountWords(words(), wordCount()); }
+
+    bool any() const{
+        for(std::size_t i = 0; i < wordCount(); ++i){
+            if(words()[i] != 0) return true;
+        }
+        return false;
+    }
+
+    bool none() const { return !any(); }
+    bool all() const { return count() == size(); }
+
+    /* [0, i)中置位的个数，i可以等于size() */
+    std::size_t rank(std::size_t i) const{
+        const std::size_t full = i / WORD_BITS;
+        std::size_t r = popcountWords(words(), full);
+        if(i % WORD_BITS != 0) r += popcountWord(words()[full] & ((std::uint64_t{1} << (i % WORD_BITS)) - 1));
+        return r;
+    }
+
+    /* 第k个(从0开始)置位的下标，不存在时返回size() */
+    std::size_t select(std::size_t k) const{
+        for(std::size_t i = 0; i < wordCount(); ++i){
+            const std::size_t c = popcountWord(words()[i]);
+            if(k < c) return i * WORD_BITS + selectInWord(words()[i], k);
+            k -= c;
+        }
+        return size();
+    }
+
+    /* 按照下标递增的顺序对每个置位的下标调用f */
+    template<typename F>
+    void forEachSetBit(F &&f) const{
+        for(std::size_t i = 0; i < wordCount(); ++i){
+            std::uint64_t w = words()[i];
+            while(w != 0){
+                f(i * WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(w)));
+                w &= w - 1;
+            }
+        }
+    }
+
+    /* 下标不小于from的第一个置位，不存在时返回size() */
+    std::size_t findNext(std::size_t from) const{
+        if(from >= size()) return size();
+        std::size_t i = from / WORD_BITS;
+        std::uint64_t w = words()[i] & (~std::uint64_t{0} << (from % WORD_BITS));
+        while(w == 0){
+            if(++i == wordCount()) return size();
+            w = words()[i];
+        }
+        return i * WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(w));
+    }
+
+    std::size_t findFirst() const { return findNext(0); }
+
+    Derived& operator&= (const Derived &other) { return combine<BitOp::And>(other); }
+    Derived& operator|= (const Derived &other) { return combine<BitOp::Or>(other); }
+    Derived& operator^= (const Derived &other) { return combine<BitOp::Xor>(other); }
+    Derived& andNot(const Derived &other) { return combine<BitOp::AndNot>(other); }
+
+    friend Derived operator& (Derived a, const Derived &b) { return a &= b; }
+    friend Derived operator| (Derived a, const Derived &b) { return a |= b; }
+    friend Derived operator^ (Derived a, const Derived &b) { return a ^= b; }
+
+    friend bool operator== (const Derived &a, const Derived &b){
+        return a.size() == b.size() && std::memcmp(a.words(), b.words(), a.wordCount() * sizeof(std::uint64_t)) == 0;
+    }
+
+    friend bool operator!= (const Derived &a, const Derived &b) { return !(a == b); }
+
+    /* 以高位在前的顺序输出，与std::bitset的to_string相同 */
+    std::ostream& writeBinary(std::ostream &os) const{
+        char buf[256];
+        std::size_t used = 0;
+        for(std::size_t i = size(); i-- > 0;){
+            buf[used++] = test(i) ? '1' : '0';
+            if(used == sizeof(buf)){
+                os.write(buf, static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        }
+        return os.write(buf, static_cast<std::streamsize>(used));
+    }
+
+    /* 以高位在前的顺序输出十六进制数字，位数为ceil(size() / 4) */
+    std::ostream& writeHex(std::ostream &os) const{
+        static constexpr char DIGITS[] = "0123456789abcdef";
+        char buf[256];
+        std::size_t used = 0;
+        for(std::size_t d = (size() + 3) / 4; d-- > 0;){
+            const std::size_t bit = d * 4;
+            buf[used++] = DIGITS[(words()[bit / WORD_BITS] >> (bit % WORD_BITS)) & 0xf];
+            if(used == sizeof(buf)){
+                os.write(buf, static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        }
+        return os.write(buf, static_cast<std::streamsize>(used));
+    }
+
+    friend std::ostream& operator<< (std::ostream &os, const Derived &bits) { return bits.writeBinary(os); }
+
+protected:
+    static constexpr std::size_t wordsFor(std::size_t bits) { return (bits + WORD_BITS - 1) / WORD_BITS; }
+
+    void clearPadding(){
+        if(size() % WORD_BITS != 0) words()[wordCount() - 1] &= (std::uint64_t{1} << (size() % WORD_BITS)) - 1;
+    }
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+    std::uint64_t* words() { return self().words(); }
+    const std::uint64_t* words() const { return self().words(); }
+    std::size_t wordCount() const { return self().wordCount(); }
+    std::size_t size() const { return self().size(); }
+
+    template<BitOp Op>
+    Derived& combine(const Derived &other){
+        self().checkSameSize(other);
+        combineWords<Op>(words(), other.words(), wordCount());
+        return self();
+    }
+};
+
+//===============BitSet<N>===============
+template<std::size_t N>
+class BitSet : public BitSetBase<BitSet<N>>{
+    using Base = BitSetBase<BitSet<N>>;
+    friend Base;
+
+public:
+    static constexpr std::size_t WORDS = Base::wordsFor(N);
+
+    BitSet() = default;
+
+    std::uint64_t* words() { return m_words; }
+    const std::uint64_t* words() const { return m_words; }
+    static constexpr std::size_t wordCount() { return WORDS; }
+    static constexpr std::size_t size() { return N; }
+
+private:
+    void checkSameSize(const BitSet&) const {}
+
+    alignas(32) std::uint64_t m_words[WORDS == 0 ? 1 : WORDS]{};
+};
+
+//===============DynamicBitSet===============
+class DynamicBitSet : public BitSetBase<DynamicBitSet>{
+    using Base = BitSetBase<DynamicBitSet>;
+    friend Base;
+
+public:
+    DynamicBitSet() = default;
+    explicit DynamicBitSet(std::size_t n) : m_words(wordsFor(n), 0), m_size(n) {}
+
+    std::uint64_t* words() { return m_words.data(); }
+    const std::uint64_t* words() const { return m_words.data(); }
+    std::size_t wordCount() const { return m_words.size(); }
+    std::size_t size() const { return m_size; }
+
+    /* 新增的位为0 */
+    void resize(std::size_t n){
+        m_words.resize(wordsFor(n), 0);
+        m_size = n;
+        clearPadding();
+    }
+
+private:
+    void checkSameSize(const DynamicBitSet &other) const{
+        if(other.m_size != m_size) throw std::invalid_argument("DynamicBitSet: operands have different sizes");
+    }
+
+    std::vector<std::uint64_t> m_words;
+    std::size_t m_size = 0;
+};
+
+#endif
@@ -5,9 +5,12 @@
  *   也显式指定了模板参数。此外还有两种类似的语法“-> template”和“::template”，分别用于通过指针调用成员和静态成员的调用的情况。[例1]
  * 2.通用lambda表达式在C++14时引入，它被用作成员函数模板的一种简便写法，我们可以使用关键字auto来作为函数参数类型的占位符，这样就得到了一个适用于任意类型
  *   的lambda表达式。这种通用lambda表达式是对例2中的函数对象的简化。[例2]
+ * 3.bitset.hpp中的BitSet<N>可以直接通过writeBinary或writeHex写入输出流，既不需要.template to_string<...>()，也不会构造std::string；forEachSetBit
+ *   只访问置位的位，rank和select则是std::bitset所没有的操作。[例3]
  */
 #include <bitset>
 #include <iostream>
+#include "bitset.hpp"
 
 //===============例1===============
 template<unsigned int N>
@@ -46,7 +49,27 @@ void func2(){
     std::cout << NameGeneratedByComplier()(10UL, 20UL) << std::endl;
 }
 
+//===============例3===============
+template<std::size_t N>
+void printBitSet(const BitSet<N> &bits){
+    bits.writeBinary(std::cout) << std::endl;      //bits不是依赖于模板参数的成员模板调用，也不需要template关键字
+}
+
+void func3(){
+    BitSet<100> bits;
+    bits.set(3).set(64).set(99);
+    printBitSet(bits);
+    bits.writeHex(std::cout) << std::endl;
+
+    bits.forEachSetBit([](std::size_t i){
+        std::cout << i << " ";
+    });
+    std::cout << std::endl;
+    std::cout << bits.count() << " " << bits.rank(64) << " " << bits.select(2) << std::endl;    //3 1 99
+}
+
 int main(void){
     func1();
     func2();
+    func3();
 }
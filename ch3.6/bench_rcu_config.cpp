@@ -0,0 +1,100 @@
+/**
+ * 《并发更新时的配置读取吞吐量》
+ * 读取线程的数量依次为1到64，每个读取线程反复读取一份Settings并累加其中的字段，同时有一个写入线程每隔一段时间发布一份新的Settings。
+ * 比较CONFIG<Settings>与使用std::shared_mutex保护的全局变量，报告所有读取线程的总吞吐量以及测试期间完成的更新次数。
+ * 用法：bench_rcu_config.exe [每组测试的毫秒数] [两次更新之间的微秒数]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rcu_config.hpp"
+
+struct Settings{
+    long long timeout = 0;
+    long long retries = 0;
+    std::string endpoint = "localhost";
+};
+
+/* 对照组：读取者共享一把读写锁 */
+struct LockedSettings{
+    mutable std::shared_mutex mutex;
+    Settings value;
+
+    long long read() const{
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return value.timeout + value.retries + static_cast<long long>(value.endpoint.size());
+    }
+
+    void update(long long v){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        value.timeout = v;
+        value.retries = v + 1;
+    }
+};
+
+LockedSettings g_locked;
+
+long long readRcu(){
+    ReadGuard<Settings> s = CONFIG<Settings>.read();
+    return s->timeout + s->retries + static_cast<long long>(s->endpoint.size());
+}
+
+void updateRcu(long long v){
+    CONFIG<Settings>.update([v](Settings &s){
+        s.timeout = v;
+        s.retries = v + 1;
+    });
+}
+
+template<typename Read, typename Update>
+void run(const char *name, unsigned threads, std::chrono::milliseconds duration, std::chrono::microseconds interval, Read read, Update update){
+    std::atomic<bool> stop{false};
+    std::atomic<long long> totalReads{0}, sink{0};
+    long long updates = 0;
+
+    std::vector<std::thread> readers;
+    for(unsigned t = 0; t < threads; ++t){
+        readers.emplace_back([&]{
+            long long reads = 0, sum = 0;
+            while(!stop.load(std::memory_order_relaxed)){
+                for(int i = 0; i < 64; ++i) sum += read();
+                reads += 64;
+            }
+            totalReads += reads;
+            sink += sum;
+        });
+    }
+
+    std::thread writer([&]{
+        while(!stop.load(std::memory_order_relaxed)){
+            update(++updates);
+            std::this_thread::sleep_for(interval);
+        }
+    });
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for(std::thread &r : readers) r.join();
+    writer.join();
+
+    const double seconds = std::chrono::duration<double>(duration).count();
+    std::cout << name << "\t" << threads << "\t" << totalReads / seconds / 1e6 << " M reads/s\t" << updates << " updates\t(sink " << sink << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::chrono::milliseconds duration(argc > 1 ? std::strtol(argv[1], nullptr, 10) : 500);
+    std::chrono::microseconds interval(argc > 2 ? std::strtol(argv[2], nullptr, 10) : 100);
+
+    CONFIG<Settings>.store(Settings{});
+    std::cout << "membarrier: " << (rcu::useMembarrier() ? "yes" : "no") << std::endl;
+    for(unsigned threads = 1; threads <= 64; threads *= 2){
+        run("CONFIG      ", threads, duration, interval, readRcu, updateRcu);
+        run("shared_mutex", threads, duration, interval, [](){ return g_locked.read(); }, [](long long v){ g_locked.update(v); });
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * 《计数器的并发递增吞吐量》
+ * 线程数依次为1到64，每个线程对同一个计数器递增若干次。比较三种计数器：
+ *   1.single atomic：一个全局的std::atomic<long long>，所有线程修改同一个缓存行。
+ *   2.packed array：每个线程有自己的std::atomic<long long>，但它们紧密排列在一个数组中，相邻线程的计数器位于同一个缓存行(伪共享)。
+ *   3.sharded：sharded<Tag>，每个分片独占一个缓存行。
+ * 用法：bench_sharded.exe [每个线程的递增次数]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "sharded.hpp"
+
+struct Hits;
+
+std::atomic<long long> g_single{0};
+std::atomic<long long> g_packed[64];
+
+template<typename F, typename Total>
+void run(const char *name, unsigned threads, long long perThread, F increment, Total total){
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for(unsigned t = 0; t < threads; ++t){
+        workers.emplace_back([=]{
+            for(long long i = 0; i < perThread; ++i) increment(t);
+        });
+    }
+    for(std::thread &w : workers) w.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    std::cout << name << "\t" << threads << "\t" << threads * perThread / elapsed.count() / 1e6 << " M incs/s\t(total " << total() << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    long long perThread = (argc > 1) ? std::strtoll(argv[1], nullptr, 10) : 10000000;
+
+    for(unsigned threads = 1; threads <= 64; threads *= 2){
+        g_single = 0;
+        run("single atomic", threads, perThread,
+            [](unsigned){ g_single.fetch_add(1, std::memory_order_relaxed); },
+            []{ return g_single.load(); });
+
+        for(std::atomic<long long> &c : g_packed) c = 0;
+        run("packed array ", threads, perThread,
+            [](unsigned t){ g_packed[t % 64].fetch_add(1, std::memory_order_relaxed); },
+            []{ long long sum = 0; for(const std::atomic<long long> &c : g_packed) sum += c.load(); return sum; });
+
+        sharded<Hits>.reset();
+        run("sharded      ", threads, perThread,
+            [](unsigned){ ++sharded<Hits>; },
+            []{ return sharded<Hits>.load(); });
+    }
+}
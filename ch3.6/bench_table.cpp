@@ -0,0 +1,56 @@
+/**
+ * 《查表与std::sin》
+ * 1.启动开销：RUNTIME_SIN是一张在动态初始化阶段通过std::sin填写的表，这就是不使用constexpr时在程序启动时需要付出的代价。同一个翻译单元中的全局变量
+ *   按照定义的顺序初始化，因此在它前后记录的两个时间点之差就是它的初始化耗时；而sin_table在编译时生成，没有对应的初始化代码。
+ * 2.吞吐量：对随机的角度分别调用std::sin和lookupSin求和，并报告查表结果的最大误差。
+ * 用法：bench_table.exe [调用次数]
+ */
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "table.hpp"
+
+constexpr std::size_t N = 4096;
+
+std::array<double, N> fillRuntimeSin(){
+    std::array<double, N> table;
+    for(std::size_t i = 0; i < N; ++i) table[i] = std::sin(TWO_PI_V<double> * i / N);
+    return table;
+}
+
+static const auto g_initBegin = std::chrono::steady_clock::now();
+static const std::array<double, N> RUNTIME_SIN = fillRuntimeSin();
+static const auto g_initEnd = std::chrono::steady_clock::now();
+
+template<typename F>
+void measure(const char *name, const std::vector<double> &angles, F f){
+    double sum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(double x : angles) sum += f(x);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << name << "\t" << elapsed.count() / angles.size() << " ns/call\t(sum " << sum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::chrono::duration<double, std::micro> init = g_initEnd - g_initBegin;
+    std::cout << "startup: runtime-filled table " << init.count() << " us, constexpr sin_table 0 us (in .rodata)" << std::endl;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    std::vector<double> angles(n);
+    for(double &x : angles) x = dist(rng);
+
+    measure("std::sin ", angles, [](double x){ return std::sin(x); });
+    measure("lookupSin", angles, [](double x){ return lookupSin<N>(x); });
+    measure("runtime table", angles, [](double x){ return lookupPeriodic(RUNTIME_SIN, x); });
+
+    double maxError = 0;
+    for(double x : angles) maxError = std::fmax(maxError, std::fabs(lookupSin<N>(x) - std::sin(x)));
+    std::cout << "max |lookupSin - std::sin| = " << maxError << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef CACHE_LINE_HPP
+#define CACHE_LINE_HPP
+
+#include <cstddef>
+
+/* 缓存行的大小，用于将被不同线程频繁写入的数据隔开，避免伪共享(false sharing) */
+constexpr std::size_t CACHE_LINE = 64;
+
+#endif
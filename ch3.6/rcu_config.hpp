@@ -0,0 +1,222 @@
+#ifndef RCU_CONFIG_HPP
+#define RCU_CONFIG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "cache_line.hpp"
+
+#ifdef __linux__
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * 《以RCU方式发布的按类型配置》
+ * vt.hpp中的PASSWORD<T>为每个类型提供了一个全局变量，但它在init.cpp中被写入、在func4中被读取，两者之间既没有同步，也没有确定的初始化顺序。当多个线程
+ * 读取同一份配置而偶尔有线程更新它时，这样的变量会产生数据竞争。CONFIG<T>同样是一个变量模板，它的每个实例是一个RcuCell<T>：
+ *   1.RcuCell的构造函数是constexpr的，因此CONFIG<T>在编译时完成常量初始化，不存在跨翻译单元的初始化顺序问题。
+ *   2.配置保存在堆上的一个不可修改的版本中，RcuCell只保存指向当前版本的指针。写入者先构造出完整的新版本，再通过一次原子交换发布它，读取者看到的要么是
+ *     旧版本，要么是新版本，不会看到写了一半的配置(read-copy-update)。
+ *   3.读取者通过read()获得一个ReadGuard，在ReadGuard存在期间，它指向的版本不会被释放。进入和离开读取区只是对当前线程独占的槽位进行普通的原子存储，
+ *     不包含任何读-改-写操作，也不会等待其他线程，因此是无等待(wait-free)的，并且不同线程的槽位位于不同的缓存行，读取者之间没有任何竞争。
+ *   4.写入者在发布新版本之后等待一个宽限期(grace period)：所有在发布之前进入读取区的线程都已经离开，此时没有线程再持有旧版本，写入者随后释放它。
+ *     写入者之间通过互斥锁串行化，写入的开销远大于读取，因此只适用于读多写少的场景。由于写入者需要等待所有读取者离开，持有ReadGuard的线程不能
+ *     写入任何CONFIG<T>，否则它将永远等待自己。
+ * 读取者需要保证“写入自己的槽位”先于“读取当前版本的指针”对写入者可见，这通常需要一条完整的内存屏障。在Linux上，写入者通过membarrier系统调用让所有
+ * 正在运行的线程执行一次内存屏障，因此读取者只需要一个编译器屏障；membarrier不可用时，读取者回落为使用std::atomic_thread_fence。
+ */
+
+//===============读取者的槽位===============
+namespace rcu{
+
+/* 每个线程的槽位。epoch为0表示该线程不在读取区中，否则为它进入读取区时的全局纪元 */
+struct alignas(CACHE_LINE) ReaderSlot{
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<bool> owned{false};
+    ReaderSlot *next = nullptr;
+};
+
+/* 所有槽位组成一个只增不减的链表，线程退出时归还槽位，新线程优先复用已归还的槽位 */
+inline std::atomic<ReaderSlot*> g_slots{nullptr};
+inline std::atomic<std::uint64_t> g_epoch{1};
+
+#ifdef __linux__
+inline bool registerMembarrier(){
+    const long cmds = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+    if(cmds < 0 || !(cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED)) return false;
+    return syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+}
+#else
+inline bool registerMembarrier() { return false; }
+#endif
+
+inline bool useMembarrier(){
+    static const bool enabled = registerMembarrier();
+    return enabled;
+}
+
+/* 读取者一侧的屏障：membarrier可用时只需要阻止编译器重排 */
+inline void lightFence(bool membarrier){
+    if(membarrier) std::atomic_signal_fence(std::memory_order_seq_cst);
+    else std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/* 写入者一侧的屏障：让所有正在运行的线程执行一次完整的内存屏障 */
+inline void heavyFence(){
+#ifdef __linux__
+    if(useMembarrier()){
+        syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+        return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline ReaderSlot* claimSlot(){
+    for(ReaderSlot *s = g_slots.load(std::memory_order_acquire); s; s = s->next){
+        bool expected = false;
+        if(!s->owned.load(std::memory_order_relaxed) && s->owned.compare_exchange_strong(expected, true)) return s;
+    }
+
+    ReaderSlot *s = new ReaderSlot;
+    s->owned.store(true, std::memory_order_relaxed);
+    s->next = g_slots.load(std::memory_order_relaxed);
+    while(!g_slots.compare_exchange_weak(s->next, s)){
+    }
+    return s;
+}
+
+inline ReaderSlot* acquireSlot(){
+    ReaderSlot *slot = claimSlot();
+    /**
+     * 与synchronize中的heavyFence配对：如果写入者遍历链表时没有看到这个新加入的槽位，那么该线程之后读取的一定是写入者已经发布的新版本。
+     * 这条屏障只在线程第一次读取时执行一次。
+     */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return slot;
+}
+
+/* 线程第一次读取时获取槽位，线程退出时归还；depth用于支持嵌套的读取区，只有最外层的进入和离开才会写入槽位 */
+struct ReaderState{
+    ReaderSlot *slot = acquireSlot();
+    bool membarrier = useMembarrier();
+    unsigned depth = 0;
+
+    ~ReaderState() { slot->owned.store(false, std::memory_order_release); }
+};
+
+inline ReaderState& readerState(){
+    thread_local ReaderState state;
+    return state;
+}
+
+inline void readLock(ReaderState &state){
+    if(state.depth++ == 0){
+        state.slot->epoch.store(g_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        lightFence(state.membarrier);
+    }
+}
+
+inline void readUnlock(ReaderState &state){
+    if(--state.depth == 0) state.slot->epoch.store(0, std::memory_order_release);
+}
+
+/* 等待所有在调用之前进入读取区的线程离开 */
+inline void synchronize(){
+    heavyFence();
+    const std::uint64_t target = g_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+    for(ReaderSlot *s = g_slots.load(std::memory_order_acquire); s; s = s->next){
+        for(;;){
+            const std::uint64_t e = s->epoch.load(std::memory_order_acquire);
+            if(e == 0 || e >= target) break;
+            std::this_thread::yield();
+        }
+    }
+}
+
+}
+
+//===============RcuCell===============
+template<typename T>
+class RcuCell;
+
+/* 在ReadGuard存在期间，它指向的版本保持有效；ReadGuard只能在创建它的线程中使用 */
+template<typename T>
+class ReadGuard{
+public:
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator= (const ReadGuard&) = delete;
+    ~ReadGuard() { rcu::readUnlock(m_state); }
+
+    const T* get() const               { return m_value; }
+    const T* operator-> () const     { return m_value; }
+    const T& operator* () const      { return *m_value; }
+    explicit operator bool() const  { return m_value != nullptr; }
+
+private:
+    friend class RcuCell<T>;
+    ReadGuard(rcu::ReaderState &state, const std::atomic<const T*> &current) : m_state(state){
+        rcu::readLock(m_state);
+        m_value = current.load(std::memory_order_acquire);
+    }
+
+    rcu::ReaderState &m_state;
+    const T *m_value;
+};
+
+template<typename T>
+class RcuCell{
+public:
+    constexpr RcuCell() = default;
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator= (const RcuCell&) = delete;
+    ~RcuCell() { delete m_current.load(std::memory_order_relaxed); }
+
+    /* 读取当前版本，尚未写入任何版本时ReadGuard为空 */
+    ReadGuard<T> read() const { return ReadGuard<T>(rcu::readerState(), m_current); }
+
+    /* 返回当前版本的拷贝，尚未写入任何版本时返回T() */
+    T load() const{
+        ReadGuard<T> guard = read();
+        return guard ? *guard : T();
+    }
+
+    void store(T value) { publish(new T(std::move(value))); }
+
+    /* 以当前版本(或T())的拷贝调用f进行修改，再将修改后的拷贝发布为新版本 */
+    template<typename F>
+    void update(F f){
+        std::lock_guard<std::mutex> lock(m_writer);
+        const T *old = m_current.load(std::memory_order_relaxed);
+        T *next = old ? new T(*old) : new T();
+        f(*next);
+        replace(next);
+    }
+
+private:
+    void publish(const T *next){
+        std::lock_guard<std::mutex> lock(m_writer);
+        replace(next);
+    }
+
+    void replace(const T *next){
+        const T *old = m_current.exchange(next, std::memory_order_acq_rel);
+        if(old){
+            rcu::synchronize();
+            delete old;
+        }
+    }
+
+    std::atomic<const T*> m_current{nullptr};
+    std::mutex m_writer;
+};
+
+/* 每个类型对应一份配置，与PASSWORD<T>不同，它在编译时完成初始化，并且可以被多个线程安全地读写 */
+template<typename T>
+inline RcuCell<T> CONFIG;
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SHARDED_HPP
+#define SHARDED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "cache_line.hpp"
+
+/**
+ * 《按线程分片的变量模板》
+ * PASSWORD<T>和realnums<N>这样的变量模板为每组模板参数提供唯一的一个全局变量。当它被用作计数器这类被频繁写入的统计数据时，所有线程都在修改同一个
+ * 缓存行，该缓存行会在各个核心之间来回传递，即使每次修改都是原子的，吞吐量也会随着线程数的增加而下降。Sharded<T, Shards>将一个值拆分为Shards个分片：
+ *   1.每个分片独占一个缓存行，每个线程在第一次访问时被分配一个编号，此后只修改编号对应的分片，因此不同线程的写入不会互相干扰。
+ *   2.线程数超过分片数时，多个线程会共用一个分片，此时写入仍然是原子的，只是会重新出现竞争，因此Shards应当不少于写入线程的数量。
+ *   3.load()将所有分片的值相加后返回，读取的开销与分片数成正比，适用于写多读少的场景。由于各个分片是分别读取的，load()返回的值不是某一时刻的精确快照，
+ *     但在所有写入结束之后，它返回的一定是准确的总和。
+ * 变量模板sharded<Tag, T>为每个标签类型Tag提供一个全局的Sharded<T>，它的构造函数是constexpr的，因此同样在编译时完成初始化。
+ */
+inline unsigned shardIndex(){
+    static std::atomic<unsigned> next{0};
+    thread_local const unsigned index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+template<typename T, std::size_t Shards = 64>
+class Sharded{
+public:
+    static_assert(std::is_arithmetic_v<T>, "Sharded only supports arithmetic types");
+    static_assert(Shards > 0, "Sharded needs at least one shard");
+
+    constexpr Sharded() = default;
+    Sharded(const Sharded&) = delete;
+    Sharded& operator= (const Sharded&) = delete;
+
+    void add(T delta){
+        std::atomic<T> &value = m_slots[shardIndex() % Shards].value;
+        if constexpr (std::is_integral_v<T>){
+            value.fetch_add(delta, std::memory_order_relaxed);
+        }else{
+            /* C++17中浮点类型的std::atomic没有fetch_add，使用CAS循环代替；分片通常只被一个线程写入，循环几乎总是一次成功 */
+            T old = value.load(std::memory_order_relaxed);
+            while(!value.compare_exchange_weak(old, old + delta, std::memory_order_relaxed)){
+            }
+        }
+    }
+
+    Sharded& operator+= (T delta) { add(delta); return *this; }
+    Sharded& operator++ ()            { add(T(1)); return *this; }
+
+    T load() const{
+        T sum{};
+        for(const Slot &slot : m_slots) sum += slot.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    void reset(){
+        for(Slot &slot : m_slots) slot.value.store(T{}, std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(CACHE_LINE) Slot{
+        std::atomic<T> value{};
+    };
+
+    Slot m_slots[Shards];
+};
+
+template<typename Tag, typename T = long long>
+inline Sharded<T> sharded;
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef TABLE_HPP
+#define TABLE_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * 《编译时生成的查找表》
+ * main.cpp中的realnums<N>是一个以非类型参数N为长度的std::array<double, N>，但它只是一个零值初始化的全局变量，其中的内容需要在运行时填写。
+ * 如果表中的每一项都可以由一个constexpr函数计算得到，那么整张表都可以在编译时生成：
+ *   1.make_table<N>(f)依次以0到N-1调用生成器f，并将结果保存在std::array中返回，它本身是一个constexpr函数。
+ *   2.table_v<F, N>是一个变量模板，它使用类型为F的生成器生成长度为N的表。由于它是constexpr变量，整张表在编译时就已确定，编译器会将它放在只读数据段
+ *     (.rodata)中，程序启动时不需要执行任何初始化代码；又由于它是inline变量，同一组模板参数在整个程序中只对应一张表。
+ *   3.F必须是可以默认构造的类型。在C++17中生成器需要写成一个带有constexpr operator()的类；从C++20开始，无捕获的lambda也可以默认构造，因此可以直接
+ *     写作table_v<decltype([](std::size_t i){ ... }), N>。
+ * 此外，这个文件提供了几张常用的表：正弦和余弦(sin_table、cos_table)、CRC32(crc32_table)、8位整数的置位数量(popcount_table)以及把[0, 2π)等分为N份的
+ * 角度(angle_table)，并提供了基于这些表的lookupSin、lookupCos和crc32。
+ */
+template<std::size_t N, typename F>
+constexpr auto make_table(F f){
+    using T = std::remove_cv_t<decltype(f(std::size_t{}))>;
+    std::array<T, N> table{};
+    for(std::size_t i = 0; i < N; ++i) table[i] = f(i);
+    return table;
+}
+
+template<typename F, std::size_t N>
+inline constexpr auto table_v = make_table<N>(F{});
+
+//===============常量与constexpr数学函数===============
+/* 与main.cpp中的PI<T>相同，但使用long double的完整精度 */
+template<typename T>
+inline constexpr T PI_V = static_cast<T>(3.141592653589793238462643383279502884L);
+
+template<typename T>
+inline constexpr T TWO_PI_V = 2 * PI_V<T>;
+
+/* 将x归约到[-π, π]之后使用泰勒级数求和，|x| <= π时第15项已小于long double的精度 */
+constexpr long double constexprSinReduced(long double x){
+    long double term = x, sum = x;
+    const long double x2 = x * x;
+    for(int k = 1; k < 15; ++k){
+        term *= -x2 / static_cast<long double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr long double reduceAngle(long double x){
+    const long double turns = x / TWO_PI_V<long double>;
+    long double k = static_cast<long double>(static_cast<long long>(turns));
+    long double r = x - k * TWO_PI_V<long double>;
+    if(r > PI_V<long double>) r -= TWO_PI_V<long double>;
+    if(r < -PI_V<long double>) r += TWO_PI_V<long double>;
+    return r;
+}
+
+template<typename T>
+constexpr T constexprSin(T x){
+    return static_cast<T>(constexprSinReduced(reduceAngle(x)));
+}
+
+template<typename T>
+constexpr T constexprCos(T x){
+    return static_cast<T>(constexprSinReduced(reduceAngle(static_cast<long double>(x) + PI_V<long double> / 2)));
+}
+
+//===============生成器===============
+/* 第i项对应角度2πi/N */
+template<typename T, std::size_t N>
+struct AngleGenerator{
+    constexpr T operator() (std::size_t i) const { return static_cast<T>(TWO_PI_V<long double> * i / N); }
+};
+
+template<typename T, std::size_t N>
+struct SinGenerator{
+    constexpr T operator() (std::size_t i) const { return constexprSin<T>(AngleGenerator<T, N>{}(i)); }
+};
+
+template<typename T, std::size_t N>
+struct CosGenerator{
+    constexpr T operator() (std::size_t i) const { return constexprCos<T>(AngleGenerator<T, N>{}(i)); }
+};
+
+/* 以反转的多项式0xEDB88320计算每个字节的CRC32余数，与zlib的crc32相同 */
+struct Crc32Generator{
+    constexpr std::uint32_t operator() (std::size_t i) const{
+        std::uint32_t c = static_cast<std::uint32_t>(i);
+        for(int k = 0; k < 8; ++k) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        return c;
+    }
+};
+
+struct PopcountGenerator{
+    constexpr std::uint8_t operator() (std::size_t i) const{
+        std::uint8_t n = 0;
+        for(; i; i &= i - 1) ++n;
+        return n;
+    }
+};
+
+//===============常用的表===============
+template<typename T, std::size_t N>
+inline constexpr auto angle_table = table_v<AngleGenerator<T, N>, N>;
+
+template<typename T, std::size_t N>
+inline constexpr auto sin_table = table_v<SinGenerator<T, N>, N>;
+
+template<typename T, std::size_t N>
+inline constexpr auto cos_table = table_v<CosGenerator<T, N>, N>;
+
+inline constexpr auto crc32_table = table_v<Crc32Generator, 256>;
+
+inline constexpr auto popcount_table = table_v<PopcountGenerator, 256>;
+
+//===============查表===============
+/**
+ * 在长度为N的表中查找x对应的值，并在相邻的两项之间线性插值。N必须是2的幂，这样下标的回绕只需要一次按位与运算。
+ * N为4096时，对于double的正弦和余弦，插值的误差不超过3e-7。
+ */
+template<std::size_t N, typename T>
+T lookupPeriodic(const std::array<T, N> &table, T x){
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the table length must be a power of two");
+    constexpr T scale = static_cast<T>(N) / TWO_PI_V<T>;
+
+    const T pos = x * scale;
+    long long i = static_cast<long long>(pos);
+    if(pos < static_cast<T>(i)) --i;     //向负无穷取整
+    const T frac = pos - static_cast<T>(i);
+
+    const std::size_t a = static_cast<std::size_t>(i) & (N - 1);
+    const std::size_t b = (a + 1) & (N - 1);
+    return table[a] + (table[b] - table[a]) * frac;
+}
+
+template<std::size_t N = 4096, typename T>
+T lookupSin(T x){
+    return lookupPeriodic(sin_table<T, N>, x);
+}
+
+template<std::size_t N = 4096, typename T>
+T lookupCos(T x){
+    return lookupPeriodic(cos_table<T, N>, x);
+}
+
+inline std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc = 0){
+    const unsigned char *p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for(std::size_t i = 0; i < size; ++i) crc = crc32_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * 《InplaceFunction与std::function的调用延迟》
+ * 1.调用：预先构造好一组包装器，依次调用它们，测量每次调用的平均耗时。
+ * 2.延迟回调：每轮将一批lambda包装后放入队列，然后依次调用并清空队列，测量每个回调从构造到销毁的平均耗时，并统计堆内存分配的次数。
+ * 可调用对象分别为捕获8字节和捕获24字节的lambda，libstdc++的std::function只能内联保存16字节以内的可调用对象。
+ * 用法：bench_inplace_function.exe [回调数量]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "inplace_function.hpp"
+
+//===============分配计数===============
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size){
+    ++g_allocations;
+    if(void *p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept                   { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+constexpr std::size_t BATCH = 1024;
+
+struct Small{
+    long long a;
+    long long operator() (long long x) const { return x + a; }
+};
+
+struct Large{
+    long long a = 0, b = 0, c = 0;
+    long long operator() (long long x) const { return x * a + b - c; }
+};
+
+template<typename Wrapper, typename Callable>
+void measure(const char *name, std::size_t n){
+    /* 调用 */
+    std::vector<Wrapper> wrappers;
+    for(std::size_t i = 0; i < BATCH; ++i) wrappers.emplace_back(Callable{static_cast<long long>(i)});
+
+    long long sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t done = 0; done < n; done += BATCH){
+        for(const Wrapper &w : wrappers) sink = w(sink);
+    }
+    std::chrono::duration<double, std::nano> invokeNs = std::chrono::steady_clock::now() - begin;
+
+    /* 延迟回调 */
+    std::vector<Wrapper> queue;
+    queue.reserve(BATCH);
+    const std::size_t allocBefore = g_allocations;
+    begin = std::chrono::steady_clock::now();
+    for(std::size_t done = 0; done < n; done += BATCH){
+        for(std::size_t i = 0; i < BATCH; ++i) queue.emplace_back(Callable{static_cast<long long>(i)});
+        for(Wrapper &w : queue) sink = w(sink);
+        queue.clear();
+    }
+    std::chrono::duration<double, std::nano> deferredNs = std::chrono::steady_clock::now() - begin;
+    const std::size_t allocations = g_allocations - allocBefore;
+
+    std::cout << name << "\t" << invokeNs.count() / n << "\t\t" << deferredNs.count() / n << "\t\t"
+              << static_cast<double>(allocations) / n << "\t(sink " << sink << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::cout << "wrapper\t\t\t\tinvoke(ns)\tdeferred(ns)\tallocs/callback" << std::endl;
+    measure<std::function<long long(long long)>, Small>("std::function   8B", n);
+    measure<InplaceFunction<long long(long long)>, Small>("InplaceFunction 8B", n);
+    measure<std::function<long long(long long)>, Large>("std::function   24B", n);
+    measure<InplaceFunction<long long(long long)>, Large>("InplaceFunction 24B", n);
+}
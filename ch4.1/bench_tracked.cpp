@@ -0,0 +1,82 @@
+/**
+ * 《三种转发方式的拷贝次数与耗时》
+ * X是一个带有较大负载(默认64KB)的Tracked<std::vector<char>>，g的三个重载与main.cpp中的e1::g相同，只是读取参数而不输出。分别使用例1的重载(e1)、
+ * 例2的传值(e2)以及例3的完美转发(e3)将左值、const左值、将亡值(std::move)和纯右值传递给g，报告每次调用的耗时以及每次调用发生的构造、拷贝和移动次数。
+ * 将亡值和纯右值的调用都包括构造参数本身(一次构造和一次负载分配)，这部分开销对三种方式是相同的。
+ * 用法：bench_tracked.exe [调用次数] [负载字节数]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <source_location>
+#include <utility>
+#include <vector>
+#include "tracked.hpp"
+
+using Payload = std::vector<char>;
+using X = Tracked<Payload>;
+
+static std::size_t g_payload = 64 * 1024;
+static long long g_sink = 0;
+
+/* g不内联，使每次调用都真正执行，而不会被移出循环 */
+__attribute__((noinline)) void g(X &lvalue)        { g_sink += lvalue.value().size(); }
+__attribute__((noinline)) void g(const X &cvalue) { g_sink += cvalue.value().size() + 1; }
+__attribute__((noinline)) void g(X &&rvalue)       { g_sink += rvalue.value().size() + 2; }
+
+/* 与main.cpp中的例1、例2、例3相同 */
+namespace e1{
+void f(X &lvalue)         { g(lvalue); }
+void f(const X &cvalue)  { g(cvalue); }
+void f(X &&rvalue)        { g(std::move(rvalue)); }
+}
+
+namespace e2{
+template<typename T>
+void f(T val) { g(val); }
+}
+
+namespace e3{
+template<typename T>
+void f(T &&val) { g(std::forward<T>(val)); }
+}
+
+/* 先在没有CallSite的情况下计时，再以CallSite统计一部分调用的拷贝次数，避免查找调用位置的开销影响计时结果 */
+template<typename Call>
+void runCase(const char *label, std::size_t calls, Call call, std::source_location where = std::source_location::current()){
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < calls; ++i) call();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << std::left << std::setw(28) << label << elapsed.count() / calls << " ns/call" << std::endl;
+
+    for(std::size_t i = 0; i < 1000; ++i){
+        CallSite site(label, where);
+        call();
+    }
+}
+
+int main(int argc, char *argv[]){
+    std::size_t calls = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    if(argc > 2) g_payload = std::strtoull(argv[2], nullptr, 10);
+
+    X x{Payload(g_payload)};
+    const X cx{Payload(g_payload)};
+
+    runCase("e1 lvalue", calls, [&]{ e1::f(x); });
+    runCase("e1 const lvalue", calls, [&]{ e1::f(cx); });
+    runCase("e1 xvalue", calls, [&]{ X tmp{Payload(g_payload)}; e1::f(std::move(tmp)); });
+    runCase("e1 prvalue", calls, [&]{ e1::f(X{Payload(g_payload)}); });
+    runCase("e2 lvalue", calls, [&]{ e2::f(x); });
+    runCase("e2 const lvalue", calls, [&]{ e2::f(cx); });
+    runCase("e2 xvalue", calls, [&]{ X tmp{Payload(g_payload)}; e2::f(std::move(tmp)); });
+    runCase("e2 prvalue", calls, [&]{ e2::f(X{Payload(g_payload)}); });
+    runCase("e3 lvalue", calls, [&]{ e3::f(x); });
+    runCase("e3 const lvalue", calls, [&]{ e3::f(cx); });
+    runCase("e3 xvalue", calls, [&]{ X tmp{Payload(g_payload)}; e3::f(std::move(tmp)); });
+    runCase("e3 prvalue", calls, [&]{ e3::f(X{Payload(g_payload)}); });
+
+    std::cout << std::endl << "per call (payload " << g_payload << " bytes):" << std::endl;
+    reportSites(std::cout);
+    std::cout << "(sink " << g_sink << ")" << std::endl;
+}
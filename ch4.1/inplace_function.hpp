@@ -0,0 +1,133 @@
+#ifndef INPLACE_FUNCTION_HPP
+#define INPLACE_FUNCTION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《内联存储的函数包装器》
+ * std::function可以保存任意可调用对象，但当可调用对象较大时(例如捕获了多个变量的lambda)，它会在堆上分配内存来保存该对象。InplaceFunction<R(Args...), Capacity>
+ * 提供与std::function相同的用法，但可调用对象总是保存在对象内部一块大小为Capacity的缓冲区中：
+ *   1.可调用对象的大小超过Capacity或者对齐要求超过std::max_align_t时，构造会在编译时失败，因此InplaceFunction永远不会分配内存。
+ *   2.调用时，operator()的参数类型与Args完全相同，并且通过std::forward<Args>传递给可调用对象，与例3中e3::f的做法一致：Args为X&时转发左值，为const X&时
+ *     转发const左值，为X&&或X时转发右值。因此InplaceFunction<void(X&&)>保存的可调用对象收到的仍然是一个右值。
+ *   3.每种可调用对象类型对应一个调用函数和一张编译时生成的操作表(拷贝、移动、析构)，InplaceFunction保存调用函数的地址和指向操作表的指针，调用时只有
+ *     一次间接调用。
+ *   4.与std::function一样，调用一个空的InplaceFunction会抛出std::bad_function_call。
+ */
+template<typename Signature, std::size_t Capacity = 32>
+class InplaceFunction;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>{
+public:
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept { }
+
+    template<typename F, typename D = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<D, InplaceFunction> && std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction(F &&f){
+        static_assert(sizeof(D) <= Capacity, "the callable does not fit into the inline buffer, increase Capacity");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "the callable is over-aligned");
+        static_assert(std::is_copy_constructible_v<D>, "the callable must be copy constructible");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "the callable must be nothrow move constructible");
+
+        ::new (static_cast<void*>(m_storage)) D(std::forward<F>(f));
+        m_invoke = &invoke<D>;
+        m_ops = &OPS<D>;
+    }
+
+    InplaceFunction(const InplaceFunction &other) : m_invoke(other.m_invoke), m_ops(other.m_ops){
+        if(m_ops) m_ops->copy(m_storage, other.m_storage);
+    }
+
+    InplaceFunction(InplaceFunction &&other) noexcept : m_invoke(other.m_invoke), m_ops(other.m_ops){
+        if(m_ops){
+            m_ops->move(m_storage, other.m_storage);
+            other.reset();
+        }
+    }
+
+    InplaceFunction& operator= (const InplaceFunction &other){
+        if(this != &other){
+            InplaceFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator= (InplaceFunction &&other) noexcept{
+        if(this != &other){
+            reset();
+            if(other.m_ops){
+                other.m_ops->move(m_storage, other.m_storage);
+                m_invoke = other.m_invoke;
+                m_ops = other.m_ops;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator= (std::nullptr_t) noexcept{
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    R operator() (Args... args) const{
+        if(!m_invoke) throw std::bad_function_call();
+        return m_invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    void reset() noexcept{
+        if(m_ops){
+            if(m_ops->destroy) m_ops->destroy(m_storage);
+            m_invoke = nullptr;
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    using Invoker = R (*)(void*, Args&&...);
+
+    struct Ops{
+        void (*copy)(void*, const void*);
+        void (*move)(void*, void*) noexcept;
+        void (*destroy)(void*) noexcept;     //可平凡析构的可调用对象不需要析构，此时为nullptr，以省去一次间接调用
+    };
+
+    /* 可调用对象保存在缓冲区中，它本身不是const的，因此operator()虽然是const成员函数，仍然可以调用可调用对象的非const operator()，这与std::function相同 */
+    template<typename D>
+    static R invoke(void *storage, Args&&... args){
+        if constexpr (std::is_void_v<R>){
+            std::invoke(*static_cast<D*>(storage), std::forward<Args>(args)...);
+        }else{
+            return std::invoke(*static_cast<D*>(storage), std::forward<Args>(args)...);
+        }
+    }
+
+    template<typename D>
+    static void copy(void *dst, const void *src) { ::new (dst) D(*static_cast<const D*>(src)); }
+
+    template<typename D>
+    static void move(void *dst, void *src) noexcept { ::new (dst) D(std::move(*static_cast<D*>(src))); }
+
+    template<typename D>
+    static void destroy(void *storage) noexcept { static_cast<D*>(storage)->~D(); }
+
+    template<typename D>
+    static constexpr Ops OPS{&copy<D>, &move<D>, std::is_trivially_destructible_v<D> ? nullptr : &destroy<D>};
+
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+    Invoker m_invoke = nullptr;     //与std::function一样直接保存调用函数的地址，调用时不需要先读取操作表
+    const Ops *m_ops = nullptr;
+};
+
+#endif
@@ -12,8 +12,11 @@
  * (b) 模板参数形式的T&&是一个“转发引用”，也被称为万能引用，它可以绑定可修改、不可修改或者是可移动对象，并且也会保留原对象的基本属性。
  * 需要注意，作为转发引用，T必须是一个模板参数的名字，而不能是依赖于模板参数的名字(例如std::vector<T>)，像std::vector<T>&&这种形式的引用仅是一个右值
  * 引用，并不能是转发引用。
+ *   5.同样的规则也适用于保存可调用对象的包装器。InplaceFunction<void(Args...)>在调用时通过std::forward<Args>将参数传递给它保存的可调用对象，因此无论参数是
+ * 左值、const左值还是右值，都会被原样转发到e1::g中。[例4]
  */
 #include <iostream>
+#include "inplace_function.hpp"
 
 struct X{ };
 
@@ -93,6 +96,33 @@ void func3(){
 
 }
 
+//===============例4===============
+namespace e4{
+
+/* 与e3::f相同的转发逻辑，写成一个泛型lambda以便保存到InplaceFunction中 */
+auto forwardToG = [](auto &&val){ e1::g(std::forward<decltype(val)>(val)); };
+
+void func4(){
+    X x;
+    const X cx;
+
+    InplaceFunction<void(X&)> f1 = forwardToG;
+    InplaceFunction<void(const X&)> f2 = forwardToG;
+    InplaceFunction<void(X&&)> f3 = forwardToG;
+    InplaceFunction<void(X)> f4 = forwardToG;      //参数按值传递，InplaceFunction将其作为右值转发给可调用对象
+
+    f1(x);
+    f2(cx);
+    f3(X());
+    f4(x);
+
+    /* 直接保存e1::g的某个重载，转发的结果与直接调用该重载相同 */
+    InplaceFunction<void(X&&)> g3 = static_cast<void(*)(X&&)>(e1::g);
+    g3(std::move(x));
+}
+
+}
+
 int main(void){
     e1::func1();
     std::cout << "----------" << std::endl;
@@ -100,5 +130,7 @@ int main(void){
     std::cout << "----------" << std::endl;
     e3::func3();
     std::cout << "----------" << std::endl;
+    e4::func4();
+    std::cout << "----------" << std::endl;
 
 }
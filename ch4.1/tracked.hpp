@@ -0,0 +1,176 @@
+#ifndef TRACKED_HPP
+#define TRACKED_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * 《统计拷贝与移动的次数》
+ * 4.5和4.6讨论了传值与传引用时哪些拷贝会发生、哪些会被省略，例2中的e2::f(T val)也说明了传值会导致额外的拷贝。Tracked<T>包装了一个T类型的值，并统计它的
+ * 构造、拷贝、移动和析构的次数，以及这些操作涉及的字节数，从而可以直接测量出某种参数传递方式的开销：
+ *   1.构造(constructs)包括默认构造和从T构造；拷贝构造与拷贝赋值都计为拷贝，移动构造与移动赋值都计为移动。
+ *   2.拷贝涉及的字节数由trackedBytes(value)给出，默认为sizeof(T)，对于std::vector和std::string还包括它们在堆上的元素；移动只涉及对象本身，计为sizeof(T)。
+ *   3.CallSite是一个RAII对象，它在存在期间将统计结果额外记录到创建它的源代码位置(std::source_location)名下，同一位置多次创建的CallSite共用一份记录，
+ *     因此可以分别得到每个调用位置的拷贝次数。CallSite可以嵌套，此时统计结果只记录到最内层的CallSite名下。
+ *   4.所有统计数据都是线程独有的。
+ */
+struct TrackCounts{
+    std::size_t constructs = 0;
+    std::size_t copies = 0;
+    std::size_t moves = 0;
+    std::size_t destructs = 0;
+    std::size_t copyBytes = 0;
+    std::size_t moveBytes = 0;
+
+    TrackCounts& operator+= (const TrackCounts &other){
+        constructs += other.constructs;
+        copies += other.copies;
+        moves += other.moves;
+        destructs += other.destructs;
+        copyBytes += other.copyBytes;
+        moveBytes += other.moveBytes;
+        return *this;
+    }
+
+    friend TrackCounts operator- (TrackCounts a, const TrackCounts &b){
+        a.constructs -= b.constructs;
+        a.copies -= b.copies;
+        a.moves -= b.moves;
+        a.destructs -= b.destructs;
+        a.copyBytes -= b.copyBytes;
+        a.moveBytes -= b.moveBytes;
+        return a;
+    }
+};
+
+inline TrackCounts& trackCounts(){
+    thread_local TrackCounts counts;
+    return counts;
+}
+
+//===============调用位置===============
+struct SiteRecord{
+    std::string label;
+    std::source_location where;
+    std::size_t entries = 0;     //该位置的CallSite被创建的次数
+    TrackCounts counts;
+};
+
+inline std::vector<std::unique_ptr<SiteRecord>>& siteRecords(){
+    thread_local std::vector<std::unique_ptr<SiteRecord>> records;
+    return records;
+}
+
+inline SiteRecord*& currentSite(){
+    thread_local SiteRecord *site = nullptr;
+    return site;
+}
+
+class CallSite{
+public:
+    explicit CallSite(std::string_view label, std::source_location where = std::source_location::current())
+        : m_previous(currentSite()){
+        SiteRecord *record = find(where);
+        if(!record){
+            siteRecords().push_back(std::make_unique<SiteRecord>(SiteRecord{std::string(label), where, 0, {}}));
+            record = siteRecords().back().get();
+        }
+        ++record->entries;
+        currentSite() = record;
+    }
+
+    CallSite(const CallSite&) = delete;
+    CallSite& operator= (const CallSite&) = delete;
+    ~CallSite() { currentSite() = m_previous; }
+
+private:
+    static SiteRecord* find(const std::source_location &where){
+        for(const std::unique_ptr<SiteRecord> &r : siteRecords()){
+            if(r->where.line() == where.line() && r->where.column() == where.column() && std::strcmp(r->where.file_name(), where.file_name()) == 0){
+                return r.get();
+            }
+        }
+        return nullptr;
+    }
+
+    SiteRecord *m_previous;
+};
+
+/* 以每次进入该位置为单位输出各个调用位置的统计结果 */
+inline void reportSites(std::ostream &os){
+    os << std::left << std::setw(28) << "site" << "entries\tconstructs\tcopies\tmoves\tdestructs\tcopied bytes" << std::endl;
+    for(const std::unique_ptr<SiteRecord> &r : siteRecords()){
+        const double n = r->entries ? static_cast<double>(r->entries) : 1.0;
+        os << std::left << std::setw(28) << r->label << r->entries << "\t" << r->counts.constructs / n << "\t\t" << r->counts.copies / n << "\t"
+           << r->counts.moves / n << "\t" << r->counts.destructs / n << "\t\t" << r->counts.copyBytes / n << std::endl;
+    }
+}
+
+//===============Tracked===============
+template<typename T>
+std::size_t trackedBytes(const T&) { return sizeof(T); }
+
+template<typename E, typename A>
+std::size_t trackedBytes(const std::vector<E, A> &v) { return sizeof(v) + v.size() * sizeof(E); }
+
+template<typename C, typename Tr, typename A>
+std::size_t trackedBytes(const std::basic_string<C, Tr, A> &s) { return sizeof(s) + s.size() * sizeof(C); }
+
+enum class TrackEvent{ Construct, Copy, Move, Destruct };
+
+inline void trackEvent(TrackEvent event, std::size_t bytes){
+    auto apply = [event, bytes](TrackCounts &c){
+        switch(event){
+            case TrackEvent::Construct: ++c.constructs; break;
+            case TrackEvent::Copy:      ++c.copies; c.copyBytes += bytes; break;
+            case TrackEvent::Move:      ++c.moves; c.moveBytes += bytes; break;
+            case TrackEvent::Destruct:  ++c.destructs; break;
+        }
+    };
+    apply(trackCounts());
+    if(SiteRecord *site = currentSite()) apply(site->counts);
+}
+
+template<typename T>
+class Tracked{
+public:
+    Tracked() : m_value() { trackEvent(TrackEvent::Construct, 0); }
+    explicit Tracked(const T &value) : m_value(value) { trackEvent(TrackEvent::Construct, 0); }
+    explicit Tracked(T &&value) : m_value(std::move(value)) { trackEvent(TrackEvent::Construct, 0); }
+
+    Tracked(const Tracked &other) : m_value(other.m_value) { trackEvent(TrackEvent::Copy, trackedBytes(m_value)); }
+    Tracked(Tracked &&other) noexcept(std::is_nothrow_move_constructible_v<T>) : m_value(std::move(other.m_value)){
+        trackEvent(TrackEvent::Move, sizeof(T));
+    }
+
+    Tracked& operator= (const Tracked &other){
+        m_value = other.m_value;
+        trackEvent(TrackEvent::Copy, trackedBytes(m_value));
+        return *this;
+    }
+
+    Tracked& operator= (Tracked &&other) noexcept(std::is_nothrow_move_assignable_v<T>){
+        m_value = std::move(other.m_value);
+        trackEvent(TrackEvent::Move, sizeof(T));
+        return *this;
+    }
+
+    ~Tracked() { trackEvent(TrackEvent::Destruct, 0); }
+
+    T& value()                   { return m_value; }
+    const T& value() const  { return m_value; }
+
+private:
+    T m_value;
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * 《编译时判断质数的开销》
+ * 在编译时统计小于LIMIT的质数的数量，METHOD选择所使用的方法：
+ *   1.main.cpp中例1的IsPrime<P>，对每个P递归实例化约P/2个DoIsPrime。
+ *   2.main.cpp中例2的isPrime11，每个P在常量求值中递归约P/2层，受-fconstexpr-depth(默认为512)的限制。
+ *   3.main.cpp中例3的isPrime14。
+ *   4.prime_table.hpp中的PrimeTable<LIMIT>。
+ * 这个文件本身不需要运行，它的编译时间就是测试的结果，通过“make bench_compile LIMIT=...”依次编译四种方法并报告各自的耗时。
+ */
+#include <cstdio>
+#include <utility>
+#include "prime_table.hpp"
+
+#ifndef METHOD
+#define METHOD 4
+#endif
+
+#ifndef LIMIT
+#define LIMIT 1000
+#endif
+
+#if METHOD == 1
+/* 与main.cpp中例1的IsPrime相同 */
+template<unsigned P, unsigned D>
+struct DoIsPrime { static constexpr bool value = (P % D != 0) && (DoIsPrime<P, D-1>::value); };
+
+template<unsigned P>
+struct DoIsPrime<P,2> { static constexpr bool value = (P % 2 != 0); };
+
+template<unsigned P>
+struct IsPrime { static constexpr bool value = DoIsPrime<P, P/2>::value; };
+
+template<> struct IsPrime<0> { static constexpr bool value = false; };
+template<> struct IsPrime<1> { static constexpr bool value = false; };
+template<> struct IsPrime<2> { static constexpr bool value = true; };
+template<> struct IsPrime<3> { static constexpr bool value = true; };
+
+template<unsigned... P>
+constexpr std::size_t countPrimes(std::integer_sequence<unsigned, P...>){
+    return (std::size_t{IsPrime<P>::value} + ...);
+}
+
+constexpr std::size_t primes = countPrimes(std::make_integer_sequence<unsigned, LIMIT>{});
+
+#elif METHOD == 2 || METHOD == 3
+/* 与main.cpp中例2的isPrime11和例3的isPrime14相同 */
+constexpr bool doIsPrime(unsigned p, unsigned d){
+    return (d == 2) ? (p % 2 != 0) : (p % d != 0) && doIsPrime(p, d-1);
+}
+
+constexpr bool isPrime11(unsigned p){
+    return (p < 4) ? (p / 2) : doIsPrime(p, p/2);
+}
+
+constexpr bool isPrime14(unsigned p){
+    for(unsigned i = 2; i <= p/2; i++){
+        if(p % i == 0){
+            return false;
+        }
+    }
+    return p > 1;
+}
+
+constexpr std::size_t countPrimes(){
+    std::size_t n = 0;
+    for(unsigned p = 0; p < LIMIT; ++p) n += (METHOD == 2 ? isPrime11(p) : isPrime14(p)) ? 1 : 0;
+    return n;
+}
+
+constexpr std::size_t primes = countPrimes();
+
+#else
+constexpr std::size_t primes = primeTable<LIMIT>.count();
+#endif
+
+int main(){
+    std::printf("%zu primes below %llu\n", primes, static_cast<unsigned long long>(LIMIT));
+}
@@ -0,0 +1,82 @@
+/**
+ * 《运行时判断质数的开销》
+ * 1.小于表上界(2^18)的随机数字：比较main.cpp中例2的递归isPrime11、例3的循环isPrime14以及查表的fastIsPrime。
+ * 2.超出表上界的随机数字：比较试除到平方根的循环与Miller-Rabin测试，分别测试32位和40位的数字。
+ * 试除的版本较慢，因此只测试较少的数字。
+ * 用法：bench_prime.exe [查表的次数] [试除的次数]
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "prime_table.hpp"
+
+/* 与main.cpp中例2的isPrime11相同 */
+constexpr bool doIsPrime(unsigned p, unsigned d){
+    return (d == 2) ? (p % 2 != 0) : (p % d != 0) && doIsPrime(p, d-1);
+}
+
+constexpr bool isPrime11(unsigned p){
+    return (p < 4) ? (p / 2) : doIsPrime(p, p/2);
+}
+
+/* 与main.cpp中例3的isPrime14相同 */
+constexpr bool isPrime14(unsigned p){
+    for(unsigned i = 2; i <= p/2; i++){
+        if(p % i == 0){
+            return false;
+        }
+    }
+    return p > 1;
+}
+
+bool trialDivision(std::uint64_t n){
+    if(n < 2) return false;
+    for(std::uint64_t i = 2; i * i <= n; ++i){
+        if(n % i == 0) return false;
+    }
+    return true;
+}
+
+std::vector<std::uint64_t> randomNumbers(std::size_t count, std::uint64_t lo, std::uint64_t hi){
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::uint64_t> dist(lo, hi - 1);
+    std::vector<std::uint64_t> out(count);
+    for(std::uint64_t &n : out) n = dist(rng);
+    return out;
+}
+
+template<typename F>
+void measure(const char *name, const std::vector<std::uint64_t> &numbers, F f){
+    std::size_t primes = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::uint64_t n : numbers) primes += f(n) ? 1 : 0;
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << name << "\t" << elapsed.count() / numbers.size() << " ns/query\t(primes " << primes << "/" << numbers.size() << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t fast = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t slow = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000;
+
+    const std::uint64_t bound = DEFAULT_PRIME_BOUND;
+    std::vector<std::uint64_t> small = randomNumbers(slow, 0, bound);
+    std::vector<std::uint64_t> many = randomNumbers(fast, 0, bound);
+
+    std::cout << "n < 2^18" << std::endl;
+    measure("isPrime11(recursive)", small, [](std::uint64_t n){ return isPrime11(static_cast<unsigned>(n)); });
+    measure("isPrime14(loop)     ", small, [](std::uint64_t n){ return isPrime14(static_cast<unsigned>(n)); });
+    measure("trialDivision       ", small, trialDivision);
+    measure("fastIsPrime(table)  ", many, [](std::uint64_t n){ return fastIsPrime(n); });
+
+    std::vector<std::uint64_t> n32 = randomNumbers(slow, bound, std::uint64_t{1} << 32);
+    std::vector<std::uint64_t> n40 = randomNumbers(slow, std::uint64_t{1} << 32, std::uint64_t{1} << 40);
+    std::cout << "2^18 <= n < 2^32" << std::endl;
+    measure("trialDivision       ", n32, trialDivision);
+    measure("fastIsPrime(MR)     ", n32, [](std::uint64_t n){ return fastIsPrime(n); });
+    std::cout << "2^32 <= n < 2^40" << std::endl;
+    measure("trialDivision       ", n40, trialDivision);
+    measure("fastIsPrime(MR)     ", n40, [](std::uint64_t n){ return fastIsPrime(n); });
+}
@@ -0,0 +1,98 @@
+/**
+ * 《模板元编程和编译时计算》
+ * 1.模板在编译时实例化，借助递归实例化和特例化，模板可以在编译时“计算”某个问题，例如判断一个数字是否为质数。但每一层递归都是一次实例化，
+ *   IsPrime<P>需要实例化约P/2个DoIsPrime，P稍大时就会超出编译器允许的实例化深度。[例1]
+ * 2.C++11的constexpr函数可以在编译时求值，但函数体基本只能包含一条return语句，因此仍然需要通过递归迭代所有的除数。[例2]
+ * 3.从C++14开始，constexpr函数中可以使用循环等大部分控制结构。需要注意，constexpr函数只有在需要常量表达式的上下文中才一定会在编译时求值，
+ *   其他情况下可能被当作普通函数在运行时求值。[例3]
+ * 4.既然constexpr函数中可以使用循环，那么也可以在编译时执行完整的算法。prime_table.hpp在编译时用筛法生成一张质数表，运行时的判断只需要查表，
+ *   超出表的范围时使用Miller-Rabin测试。[例4]
+ */
+#include <cstdlib>
+#include <iostream>
+#include "prime_table.hpp"
+
+//===============例1===============
+template<unsigned P, unsigned D>
+struct DoIsPrime { static constexpr bool value = (P % D != 0) && (DoIsPrime<P, D-1>::value); };
+
+template<unsigned P>
+struct DoIsPrime<P,2> { static constexpr bool value = (P % 2 != 0); };
+
+template<unsigned P>
+struct IsPrime { static constexpr bool value = DoIsPrime<P, P/2>::value; };
+
+/* 下方的这些特例用于避免无限递归 */
+template<>
+struct IsPrime<0> { static constexpr bool value = false; };
+
+template<>
+struct IsPrime<1> { static constexpr bool value = false; };
+
+template<>
+struct IsPrime<2> { static constexpr bool value = true; };
+
+template<>
+struct IsPrime<3> { static constexpr bool value = true; };
+
+void func1(){
+    /* IsPrime<9>::value等效为(9 % 4 != 0) && ((9 % 3 != 0) && (9 % 2 != 0)) */
+    constexpr bool isprime = IsPrime<9>::value;
+    std::cout << isprime << std::endl;
+    std::cout << IsPrime<97>::value << std::endl;
+}
+
+//===============例2===============
+/* C++11的constexpr函数只允许一条return语句，因此使用条件操作符实现选择，使用递归实现迭代 */
+constexpr bool doIsPrime(unsigned p, unsigned d){
+    return (d == 2) ? (p % 2 != 0) : (p % d != 0) && doIsPrime(p, d-1);
+}
+
+constexpr bool isPrime11(unsigned p){
+    return (p < 4) ? (p / 2) : doIsPrime(p, p/2);
+}
+
+void func2(){
+    constexpr bool b = isPrime11(9);     //b是编译时常量，因此isPrime11(9)在编译时求值
+    std::cout << b << std::endl;
+}
+
+//===============例3===============
+constexpr bool isPrime14(unsigned p){
+    for(unsigned i = 2; i <= p/2; i++){
+        if(p % i == 0){     //除数是i而不是2
+            return false;
+        }
+    }
+
+    return p > 1; //最小的质数为2，因此要排除0、1
+}
+
+bool nineIsPrime(){
+    return isPrime14(9);     //编译器可能会也可能不会在编译时求值
+}
+
+void func3(){
+    std::cout << nineIsPrime() << std::endl;
+
+    unsigned x = static_cast<unsigned>(std::rand() % 100);
+    std::cout << isPrime14(x) << std::endl;     //x的值只有在运行时才能得知，因此isPrime14(x)在运行时求值
+}
+
+//===============例4===============
+void func4(){
+    /* 质数表在编译时生成，因此对它的查询同样可以用于常量表达式 */
+    static_assert(primeTable<1000>.count() == 168, "there are 168 primes below 1000");
+    static_assert(fastIsPrime(97) && !fastIsPrime(91), "table lookup");
+
+    std::cout << primeTable<DEFAULT_PRIME_BOUND>.count() << std::endl;     //小于2^18的质数的数量
+    std::cout << fastIsPrime(262139) << std::endl;                          //查表
+    std::cout << fastIsPrime(18446744073709551557ull) << std::endl;         //超出表的范围，使用Miller-Rabin测试
+}
+
+int main(void){
+    func1();
+    func2();
+    func3();
+    func4();
+}
@@ -0,0 +1,155 @@
+#ifndef PRIME_TABLE_HPP
+#define PRIME_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * 《编译时生成的质数表》
+ * main.cpp中的IsPrime<P>和isPrime(p)都通过试除判断一个数字是否为质数：IsPrime<P>会递归实例化约P/2个DoIsPrime，数字稍大时就会超出编译器允许的实例化
+ * 深度；constexpr函数虽然没有这个限制，但每次判断仍然需要O(p)次除法。如果需要判断的数字都小于某个编译时已知的上界，更好的做法是在编译时一次性筛出
+ * 上界以内的所有质数，将结果作为常量嵌入程序中，运行时的判断就只剩下一次查表。
+ *   1.PrimeTable<Bound>在constexpr构造函数中执行埃拉托斯特尼筛法，结果只记录奇数，每个奇数占用一位，因此上界为2^18的表只占用16KB。
+ *   2.筛法按分段进行，每一段包含SEGMENT个奇数。这使得每个循环的迭代次数都不会超过一段的长度，避免触发编译器对常量求值中单个循环迭代次数的限制
+ *     (GCC的-fconstexpr-loop-limit默认为262144)。
+ *     但常量求值的总操作数同样有限制(GCC的-fconstexpr-ops-limit默认为2^25)，并且编译器在编译时执行筛法比运行时慢得多，默认的上界2^18大约需要一秒
+ *     的编译时间；更大的上界需要相应地调高-fconstexpr-ops-limit。
+ *   3.变量模板primeTable<Bound>是一个constexpr对象，同一个上界在整个程序中只对应一张表，并且这张表存放在只读数据段中，程序启动时无需任何初始化。
+ *   4.fastIsPrime<Bound>(n)在n小于上界时查表，否则使用确定性的Miller-Rabin测试，对于任意64位无符号整数都能给出正确结果。
+ */
+template<std::uint64_t Bound>
+class PrimeTable{
+public:
+    static_assert(Bound >= 3, "PrimeTable needs a bound of at least 3");
+
+    static constexpr std::uint64_t bound = Bound;
+    static constexpr std::uint64_t SEGMENT = 1 << 15;
+
+    constexpr PrimeTable() : m_bits{} { sieve(); }
+
+    /* 判断小于bound的n是否为质数 */
+    constexpr bool isPrime(std::uint64_t n) const{
+        if(n < 3) return n == 2;
+        if((n & 1) == 0) return false;
+        return test(n >> 1);
+    }
+
+    /* 小于bound的质数的数量 */
+    constexpr std::size_t count() const{
+        std::size_t n = 1;     //2不记录在表中
+        for(std::uint64_t word : m_bits) n += static_cast<std::size_t>(__builtin_popcountll(word));
+        return n;
+    }
+
+private:
+    /* 第i位对应奇数2i+1，小于Bound的奇数共有Bound/2个 */
+    static constexpr std::uint64_t ODDS = Bound / 2;
+    static constexpr std::size_t WORDS = static_cast<std::size_t>((ODDS + 63) / 64);
+
+    constexpr bool test(std::uint64_t i) const { return (m_bits[i >> 6] >> (i & 63)) & 1; }
+    constexpr void clear(std::uint64_t i)      { m_bits[i >> 6] &= ~(std::uint64_t{1} << (i & 63)); }
+
+    constexpr void sieve(){
+        for(std::size_t w = 0; w < WORDS; ++w) m_bits[w] = ~std::uint64_t{0};
+        if(ODDS % 64 != 0) m_bits[WORDS - 1] = (std::uint64_t{1} << (ODDS % 64)) - 1;     //清除超出范围的位
+        clear(0);     //1不是质数
+
+        for(std::uint64_t lo = 0; lo < ODDS; lo += SEGMENT){
+            const std::uint64_t hi = (ODDS - lo < SEGMENT) ? ODDS : lo + SEGMENT;
+            const std::uint64_t last = 2 * hi - 1;     //本段中最大的奇数
+
+            /**
+             * 用不超过sqrt(last)的奇质数p筛去本段中p的倍数。p的第一个需要筛去的倍数是max(p*p, 本段中p的第一个奇数倍)，相邻的两个奇数倍相差2p，
+             * 对应的下标相差p。p本身位于之前的段或本段靠前的位置，在处理到它时它的所有质因子都已经被处理过，因此它的位已经是最终结果。
+             */
+            for(std::uint64_t j = 1; (2 * j + 1) * (2 * j + 1) <= last; ++j){
+                if(!test(j)) continue;
+                const std::uint64_t p = 2 * j + 1;
+                std::uint64_t start = (p * p) >> 1;
+                if(start < lo){
+                    start = lo + (p - (lo - start) % p) % p;
+                }
+                for(std::uint64_t i = start; i < hi; i += p) clear(i);
+            }
+        }
+    }
+
+    std::uint64_t m_bits[WORDS];
+};
+
+template<std::uint64_t Bound>
+inline constexpr PrimeTable<Bound> primeTable{};
+
+//===============Miller-Rabin===============
+__extension__ typedef unsigned __int128 PrimeU128;
+
+constexpr std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m){
+    return static_cast<std::uint64_t>(static_cast<PrimeU128>(a) * b % m);
+}
+
+/* n小于2^32时a * b不会超过64位，可以直接使用64位乘法和取模，这比128位的取模快得多 */
+template<bool Small>
+constexpr std::uint64_t powMod(std::uint64_t a, std::uint64_t e, std::uint64_t m){
+    std::uint64_t r = 1;
+    a %= m;
+    while(e){
+        if(e & 1) r = Small ? r * a % m : mulMod(r, a, m);
+        a = Small ? a * a % m : mulMod(a, a, m);
+        e >>= 1;
+    }
+    return r;
+}
+
+template<bool Small, std::size_t N>
+constexpr bool millerRabinBases(std::uint64_t n, const std::uint64_t (&bases)[N]){
+    /* n - 1 = d * 2^s，其中d为奇数 */
+    std::uint64_t d = n - 1;
+    int s = 0;
+    while((d & 1) == 0){
+        d >>= 1;
+        ++s;
+    }
+
+    for(std::uint64_t base : bases){
+        const std::uint64_t a = base % n;
+        if(a == 0) continue;
+
+        std::uint64_t x = powMod<Small>(a, d, n);
+        if(x == 1 || x == n - 1) continue;
+
+        bool witness = true;
+        for(int r = 1; r < s && witness; ++r){
+            x = Small ? x * x % n : mulMod(x, x, n);
+            if(x == n - 1) witness = false;
+        }
+        if(witness) return false;
+    }
+    return true;
+}
+
+/**
+ * 确定性的Miller-Rabin测试。对于小于2^32的n，以2、7、61为底就足以得到正确的结果；对于任意64位的n，使用Jim Sinclair给出的7个底。
+ * 在测试之前先用几个小质数试除，大部分合数在这一步就会被排除。
+ */
+constexpr bool millerRabin(std::uint64_t n){
+    constexpr std::uint64_t smallPrimes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if(n < 2) return false;
+    for(std::uint64_t p : smallPrimes){
+        if(n % p == 0) return n == p;
+    }
+    if(n < 37 * 37) return true;
+
+    constexpr std::uint64_t bases32[] = {2, 7, 61};
+    constexpr std::uint64_t bases64[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    if(n < (std::uint64_t{1} << 32)) return millerRabinBases<true>(n, bases32);
+    return millerRabinBases<false>(n, bases64);
+}
+
+constexpr std::uint64_t DEFAULT_PRIME_BOUND = std::uint64_t{1} << 18;
+
+template<std::uint64_t Bound = DEFAULT_PRIME_BOUND>
+constexpr bool fastIsPrime(std::uint64_t n){
+    return (n < Bound) ? primeTable<Bound>.isPrime(n) : millerRabin(n);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * 《std::sort与sortArray》
+ * 对长度SZ从2到4096的int和double数组以及长度从2到1024的std::string数组，比较std::sort与sortArray的耗时，并列出每一种可用的策略单独使用时的耗时，
+ * 其中排序网络只测试SZ不超过128的情况。每次排序前从预先生成的随机数组中复制一份，两者都包括复制的开销。
+ * 用法：bench_sort.exe [每种长度排序的元素总数]
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sized_sort.hpp"
+
+template<typename T>
+T randomValue(std::mt19937 &rng);
+
+template<>
+int randomValue<int>(std::mt19937 &rng) { return static_cast<int>(rng()); }
+
+template<>
+double randomValue<double>(std::mt19937 &rng) { return std::uniform_real_distribution<double>(-1e6, 1e6)(rng); }
+
+template<>
+std::string randomValue<std::string>(std::mt19937 &rng) { return "key_" + std::to_string(rng() % 1000000); }
+
+template<typename T, std::size_t SZ, typename F>
+double timeNs(const std::vector<std::array<T, SZ>> &inputs, std::size_t rounds, F &&sort){
+    std::array<T, SZ> work;
+    long long sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t r = 0; r < rounds; ++r){
+        for(const auto &input : inputs){
+            work = input;
+            sort(work);
+            sink += work[SZ / 2] < work[0];     //排序后应当为0
+        }
+    }
+    std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - begin;
+    if(sink != 0) std::cout << "unsorted!" << std::endl;
+    return ns.count() / (rounds * inputs.size());
+}
+
+const char* strategyName(SortStrategy s){
+    switch(s){
+        case SortStrategy::Network: return "network";
+        case SortStrategy::Insertion: return "insertion";
+        case SortStrategy::Radix: return "radix";
+        default: return "pdq";
+    }
+}
+
+template<typename T, std::size_t SZ>
+void run(const char *type, std::size_t total){
+    const std::size_t count = std::max<std::size_t>(1, 16384 / SZ);
+    const std::size_t rounds = std::max<std::size_t>(1, total / (count * SZ));
+
+    std::mt19937 rng(42);
+    std::vector<std::array<T, SZ>> inputs(count);
+    for(auto &input : inputs){
+        for(T &x : input) x = randomValue<T>(rng);
+    }
+
+    using Less = std::less<T>;
+    auto with = [&](auto strategy){
+        return timeNs(inputs, rounds, [](std::array<T, SZ> &a){ Sorter<T, SZ, Less, decltype(strategy)::value>::sort(a.data(), Less()); });
+    };
+    using Network = std::integral_constant<SortStrategy, SortStrategy::Network>;
+    using Insertion = std::integral_constant<SortStrategy, SortStrategy::Insertion>;
+    using Radix = std::integral_constant<SortStrategy, SortStrategy::Radix>;
+    using Pdq = std::integral_constant<SortStrategy, SortStrategy::Pdq>;
+
+    std::cout << type << "\t" << SZ << "\t" << std::fixed << std::setprecision(1)
+              << timeNs(inputs, rounds, [](std::array<T, SZ> &a){ std::sort(a.begin(), a.end()); }) << "\t"
+              << timeNs(inputs, rounds, [](std::array<T, SZ> &a){ sortArray(a); }) << "\t"
+              << strategyName(Sorter<T, SZ>::strategy) << "\t";
+
+    if constexpr (std::is_arithmetic_v<T> && SZ <= 128) std::cout << with(Network{});
+    else std::cout << "-";
+    std::cout << "\t" << (SZ <= 1024 ? with(Insertion{}) : 0.0) << "\t";
+    if constexpr (std::is_arithmetic_v<T>) std::cout << with(Radix{});
+    else std::cout << "-";
+    std::cout << "\t" << with(Pdq{}) << std::endl;
+}
+
+template<typename T, std::size_t... SZ>
+void runAll(const char *type, std::size_t total, std::index_sequence<SZ...>){
+    (run<T, SZ>(type, total), ...);
+}
+
+int main(int argc, char *argv[]){
+    std::size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+
+    std::cout << "type\tSZ\tstd::sort(ns)\tsortArray(ns)\tchosen\tnetwork\tinsertion\tradix\tpdq" << std::endl;
+    runAll<int>("int", total, std::index_sequence<2, 4, 8, 16, 32, 48, 64, 96, 128, 256, 512, 1024, 2048, 4096>{});
+    runAll<double>("double", total, std::index_sequence<2, 4, 8, 16, 32, 64, 128, 192, 256, 512, 1024, 4096>{});
+    runAll<std::string>("string", total / 8, std::index_sequence<2, 8, 32, 64, 128, 1024>{});
+}
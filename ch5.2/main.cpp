@@ -0,0 +1,113 @@
+/**
+ * 《使用偏特化选择执行路径》
+ * 1.通常我们会在函数内部通过if语句根据参数选择不同的实现，例如根据数组的长度是否为偶数选择创建Evener或者Odder，这个判断发生在运行时。[例1]
+ * 2.借助偏特化可以在编译时选择不同的实现：为类模板Num额外声明一个非类型参数bool iseven，并分别为true和false实现两个偏特化版本。由于isEven是
+ *   constexpr函数，因此isEven(SZ)可以作为Num的模板实参，编译器会根据它的求值结果选择相应的偏特化版本。[例2]
+ * 3.isEven(SZ)也可以用作非类型参数的默认值，这样只需使用Num<SZ>就能达到相同的目的。[例3]
+ * 4.sized_sort.hpp中的Sorter使用同样的方法，根据数组长度和元素类型在编译时选择排序网络、插入排序、基数排序或快速排序。[例4]
+ */
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include "sized_sort.hpp"
+
+constexpr bool isEven(unsigned num){
+    return num % 2 == 0;
+}
+
+//===============例1===============
+struct Evener{ Evener(){ std::cout << "Evener" << std::endl; } };
+struct Odder{ Odder(){ std::cout << "Odder" << std::endl; } };
+
+template<typename T, std::size_t SZ>
+void select1(const T (&arr)[SZ]){
+    if(isEven(SZ)){  //如果是偶数，创建Evener
+        Evener evener;
+    }else{           //否则创建Odder
+        Odder odder;
+    }
+}
+
+void func1(){
+    int a[4] = {};
+    int b[5] = {};
+    select1(a);
+    select1(b);
+}
+
+//===============例2===============
+/* 通用模板 */
+template<std::size_t SZ, bool iseven>
+struct Num{};
+
+/* 用于偶数的偏特化 */
+template<std::size_t SZ>
+struct Num<SZ, true>{ Num(){ std::cout << "Evener: " << SZ << std::endl; } };
+
+/* 用于奇数的偏特化 */
+template<std::size_t SZ>
+struct Num<SZ, false>{ Num(){ std::cout << "Odder: " << SZ << std::endl; } };
+
+template<typename T, std::size_t SZ>
+void select2(const T (&arr)[SZ]){
+    Num<SZ, isEven(SZ)> num; //可以根据SZ是否是偶数在编译时选择不同实现
+}
+
+void func2(){
+    int a[4] = {};
+    int b[5] = {};
+    select2(a);
+    select2(b);
+}
+
+//===============例3===============
+template<std::size_t SZ, bool = isEven(SZ)>
+struct Num2{};
+
+template<std::size_t SZ>
+struct Num2<SZ, true>{ Num2(){ std::cout << "Evener: " << SZ << std::endl; } };
+
+template<std::size_t SZ>
+struct Num2<SZ, false>{ Num2(){ std::cout << "Odder: " << SZ << std::endl; } };
+
+template<typename T, std::size_t SZ>
+void select3(const T (&arr)[SZ]){
+    Num2<SZ> num;    //第二个模板参数使用默认值isEven(SZ)
+}
+
+void func3(){
+    int a[4] = {};
+    int b[5] = {};
+    select3(a);
+    select3(b);
+}
+
+//===============例4===============
+template<typename T, std::size_t SZ>
+void printSorted(T (&arr)[SZ]){
+    sortArray(arr);    //等价于Sorter<T, SZ, std::less<T>, sortStrategy<T, std::less<T>>(SZ)>::sort
+    for(const T &x : arr){
+        std::cout << x << " ";
+    }
+    std::cout << std::endl;
+}
+
+void func4(){
+    int small[8] = {5, 3, 8, 1, 9, 2, 7, 4};
+    std::string names[5] = {"pear", "apple", "fig", "banana", "cherry"};
+    printSorted(small);     //排序网络
+    printSorted(names);     //插入排序
+
+    std::array<unsigned, 1000> big;
+    for(std::size_t i = 0; i < big.size(); ++i) big[i] = static_cast<unsigned>((i * 7919) % 1000);
+    sortArray(big);         //基数排序
+    std::cout << big[0] << " " << big[999] << " " << lowerBound(big, 500u) << std::endl;   //0 999 500
+}
+
+int main(void){
+    func1();
+    func2();
+    func3();
+    func4();
+}
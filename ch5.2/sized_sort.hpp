@@ -0,0 +1,418 @@
+#ifndef SIZED_SORT_HPP
+#define SIZED_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《根据数组长度选择排序算法》
+ * main.cpp中的select通过Num<SZ, isEven(SZ)>在编译时根据数组长度选择实现，Sorter<T, SZ, Compare, Strategy>使用同样的方法：第四个模板参数的默认值
+ * sortStrategy<T, Compare>(SZ)是一个constexpr函数，它根据SZ以及元素类型T和比较器Compare的特征选出一种排序算法，每种算法对应Sorter的一个偏特化。
+ *   1.Network：算术类型并且SZ不超过NETWORK_LIMIT时，使用Batcher奇偶归并排序网络。比较器序列在编译时生成并完全展开，每个比较器只包含一次比较和两次
+ *     条件赋值，没有分支。网络按照不小于SZ的2的幂生成，涉及超出SZ的位置的比较器被直接删去，这相当于在数组末尾补充了若干个无穷大的元素。
+ *   2.Insertion：其他类型在SZ不超过INSERTION_LIMIT时使用二分插入排序。插入位置由无分支的二分查找确定，查找的步数只取决于已排序部分的长度，
+ *     因此比较的次数约为log2(i!)而不是i^2/4，这对于比较代价较高的类型(例如字符串)更为重要；元素的移动对于可以平凡拷贝的类型使用memmove。
+ *   3.Radix：整数和浮点数在SZ不小于RADIX_THRESHOLD<T>并且使用默认比较器时，使用按字节的LSD基数排序。所有字节的计数在一次遍历中完成，
+ *     所有元素在某个字节上都相同时跳过该轮分配。有符号整数和浮点数先被转换为顺序相同的无符号整数。
+ *   4.Pdq：其他情况使用模式消除快速排序(pattern-defeating quicksort)。它以中位数(较大的区间使用三个三数中位数的中位数)作为基准，当区间中存在大量
+ *     与基准相同的元素时将它们一次划分出去，当划分已经有序时尝试以有限次数的插入排序完成排序，当划分多次严重失衡时改用堆排序，从而保证O(n log n)。
+ * sortArray同时接受T[SZ]和std::array<T, SZ>；lowerBound对已排序的定长数组进行无分支的二分查找，循环次数在编译时确定。
+ */
+template<typename T, typename Compare>
+constexpr bool naturalOrder = std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>;
+
+/* 基数排序只能按照键的自然顺序排序，并且键需要能够放入64位无符号整数(long double不满足) */
+template<typename T, typename Compare>
+constexpr bool radixSortable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(std::uint64_t) && naturalOrder<T, Compare>;
+
+enum class SortStrategy{ Network, Insertion, Radix, Pdq };
+
+/* Batcher网络的比较器数量约为n(log n)^2/4，长度为128的网络在测试中仍然快于其他算法，但它展开后的代码超过20KB，会挤占指令缓存 */
+constexpr std::size_t NETWORK_LIMIT = 64;
+constexpr std::size_t INSERTION_LIMIT = 32;
+
+/* 键越长，基数排序需要的分配轮数越多，因此需要更长的数组才能胜过基于比较的排序 */
+template<typename T>
+constexpr std::size_t RADIX_THRESHOLD = sizeof(T) <= 4 ? NETWORK_LIMIT + 1 : 256;
+
+template<typename T, typename Compare>
+constexpr SortStrategy sortStrategy(std::size_t size){
+    if(std::is_arithmetic_v<T> && size <= NETWORK_LIMIT) return SortStrategy::Network;
+    if(radixSortable<T, Compare> && size >= RADIX_THRESHOLD<T>) return SortStrategy::Radix;
+    if(size <= INSERTION_LIMIT) return SortStrategy::Insertion;
+    return SortStrategy::Pdq;
+}
+
+/**
+ * 使a <= b(按照comp)，对于整数编译为条件传送指令。浮点数按照自然顺序比较时使用std::min和std::max，两者的条件分别为y < x和x < y，恰好对应minsd和
+ * maxsd指令的语义；如果像整数那样共用一个比较结果，编译器会生成分支。
+ */
+template<typename T, typename Compare>
+inline void compareSwap(T &a, T &b, Compare &comp){
+    if constexpr (std::is_floating_point_v<T> && naturalOrder<T, Compare>){
+        const T x = a, y = b;
+        a = std::min(x, y);
+        b = std::max(x, y);
+    }else{
+        const bool swap = comp(b, a);
+        const T lo = swap ? b : a;
+        const T hi = swap ? a : b;
+        a = lo;
+        b = hi;
+    }
+}
+
+//===============排序网络===============
+struct Comparator{
+    std::uint8_t lo;
+    std::uint8_t hi;
+};
+
+/* 生成长度为size的Batcher奇偶归并排序网络，out为nullptr时只统计比较器的数量 */
+constexpr std::size_t batcherNetwork(std::size_t size, Comparator *out){
+    std::size_t n = 1;
+    while(n < size) n *= 2;
+
+    std::size_t count = 0;
+    for(std::size_t p = 1; p < n; p *= 2){
+        for(std::size_t k = p; k >= 1; k /= 2){
+            for(std::size_t j = k % p; j + k < n; j += 2 * k){
+                for(std::size_t i = 0; i < k && i + j + k < n; ++i){
+                    const std::size_t lo = i + j, hi = i + j + k;
+                    if(lo / (2 * p) == hi / (2 * p) && hi < size){
+                        if(out) out[count] = Comparator{static_cast<std::uint8_t>(lo), static_cast<std::uint8_t>(hi)};
+                        ++count;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template<std::size_t SZ>
+constexpr auto sortingNetwork(){
+    std::array<Comparator, batcherNetwork(SZ, nullptr)> network{};
+    batcherNetwork(SZ, network.data());
+    return network;
+}
+
+template<std::size_t SZ>
+inline constexpr auto SORTING_NETWORK = sortingNetwork<SZ>();
+
+//===============无分支的二分查找===============
+/* 返回[first, first + n)中第一个不小于value的位置，循环的次数只取决于n */
+template<typename T, typename Compare>
+inline std::size_t branchlessLowerBound(const T *first, std::size_t n, const T &value, Compare &comp){
+    const T *base = first;
+    while(n > 1){
+        const std::size_t half = n / 2;
+        base = comp(base[half], value) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - first) + (n == 1 && comp(*base, value));
+}
+
+//===============插入排序===============
+template<typename T, typename Compare>
+void binaryInsertionSort(T *first, std::size_t n, Compare &comp){
+    for(std::size_t i = 1; i < n; ++i){
+        if(!comp(first[i], first[i - 1])) continue;     //已经处于正确的位置
+        const std::size_t pos = branchlessLowerBound(first, i, first[i], comp);
+        T value = std::move(first[i]);
+        if constexpr (std::is_trivially_copyable_v<T>){
+            std::memmove(first + pos + 1, first + pos, (i - pos) * sizeof(T));
+        }else{
+            std::move_backward(first + pos, first + i, first + i + 1);
+        }
+        first[pos] = std::move(value);
+    }
+}
+
+/* 普通的插入排序，用于快速排序中较短的区间：对于算术类型，逐个移动元素比二分查找加memmove的开销更小 */
+template<typename T, typename Compare>
+void linearInsertionSort(T *first, std::size_t n, Compare &comp){
+    for(std::size_t i = 1; i < n; ++i){
+        if(!comp(first[i], first[i - 1])) continue;
+        T value = std::move(first[i]);
+        std::size_t j = i;
+        do{
+            first[j] = std::move(first[j - 1]);
+            --j;
+        }while(j > 0 && comp(value, first[j - 1]));
+        first[j] = std::move(value);
+    }
+}
+
+//===============基数排序===============
+template<typename T>
+using RadixKey = std::conditional_t<sizeof(T) <= 1, std::uint8_t,
+                 std::conditional_t<sizeof(T) <= 2, std::uint16_t,
+                 std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>>>;
+
+/* 将T转换为无符号整数，使无符号整数的大小顺序与T的顺序相同 */
+template<typename T>
+inline RadixKey<T> radixKey(T value){
+    using K = RadixKey<T>;
+    static_assert(sizeof(T) <= sizeof(K), "radixKey: T is wider than its key");
+    constexpr K SIGN = K{1} << (sizeof(K) * 8 - 1);
+    K key = 0;
+    std::memcpy(&key, &value, sizeof(T));
+    if constexpr (std::is_floating_point_v<T>){
+        return (key & SIGN) ? static_cast<K>(~key) : static_cast<K>(key | SIGN);     //负数取反，非负数只翻转符号位
+    }else if constexpr (std::is_signed_v<T>){
+        return static_cast<K>(key ^ SIGN);
+    }else{
+        return key;
+    }
+}
+
+template<typename T, std::size_t SZ>
+void radixSort(T *data){
+    constexpr std::size_t BYTES = sizeof(RadixKey<T>);
+    std::size_t counts[BYTES][256] = {};
+    for(std::size_t i = 0; i < SZ; ++i){
+        const RadixKey<T> key = radixKey(data[i]);
+        for(std::size_t b = 0; b < BYTES; ++b) ++counts[b][(key >> (8 * b)) & 0xff];
+    }
+
+    /* 较小的临时缓冲区放在栈上，较大的在堆上分配 */
+    constexpr bool onStack = SZ * sizeof(T) <= 64 * 1024;
+    std::conditional_t<onStack, std::array<T, onStack ? SZ : 1>, std::unique_ptr<T[]>> storage{};
+    T *buffer;
+    if constexpr (onStack) buffer = storage.data();
+    else{
+        storage.reset(new T[SZ]);
+        buffer = storage.get();
+    }
+
+    T *src = data, *dest = buffer;
+    for(std::size_t b = 0; b < BYTES; ++b){
+        std::size_t *count = counts[b];
+        if(count[(radixKey(src[0]) >> (8 * b)) & 0xff] == SZ) continue;     //所有元素在该字节上都相同
+
+        std::size_t offset = 0;
+        for(std::size_t d = 0; d < 256; ++d){
+            const std::size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for(std::size_t i = 0; i < SZ; ++i) dest[count[(radixKey(src[i]) >> (8 * b)) & 0xff]++] = src[i];
+        std::swap(src, dest);
+    }
+    if(src != data) std::memcpy(data, src, SZ * sizeof(T));
+}
+
+//===============模式消除快速排序===============
+constexpr std::size_t PDQ_INSERTION = 24;
+constexpr std::size_t PDQ_NINTHER = 128;
+constexpr std::size_t PDQ_PARTIAL_LIMIT = 8;
+
+template<typename T, typename Compare>
+inline void sort3(T *a, T *b, T *c, Compare &comp){
+    if(comp(*b, *a)) std::iter_swap(a, b);
+    if(comp(*c, *b)) std::iter_swap(b, c);
+    if(comp(*b, *a)) std::iter_swap(a, b);
+}
+
+/* 插入排序，元素的移动次数超过PDQ_PARTIAL_LIMIT时放弃并返回false */
+template<typename T, typename Compare>
+bool partialInsertionSort(T *first, T *last, Compare &comp){
+    std::size_t moves = 0;
+    for(T *cur = first + 1; cur < last; ++cur){
+        if(!comp(*cur, *(cur - 1))) continue;
+        T value = std::move(*cur);
+        T *hole = cur;
+        do{
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }while(hole != first && comp(value, *(hole - 1)));
+        *hole = std::move(value);
+
+        moves += static_cast<std::size_t>(cur - hole);
+        if(moves > PDQ_PARTIAL_LIMIT) return false;
+    }
+    return true;
+}
+
+/* 以*first为基准，将小于基准的元素放在左侧，不小于基准的元素放在右侧。返回基准的最终位置以及划分前是否已经满足划分的要求 */
+template<typename T, typename Compare>
+std::pair<T*, bool> partitionRight(T *begin, T *end, Compare &comp){
+    T pivot = std::move(*begin);
+    T *first = begin, *last = end;
+
+    while(comp(*++first, pivot));
+    if(first - 1 == begin){
+        while(first < last && !comp(*--last, pivot));
+    }else{
+        while(!comp(*--last, pivot));
+    }
+
+    const bool alreadyPartitioned = first >= last;
+    while(first < last){
+        std::iter_swap(first, last);
+        while(comp(*++first, pivot));
+        while(!comp(*--last, pivot));
+    }
+
+    T *pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return {pivotPos, alreadyPartitioned};
+}
+
+/* 与partitionRight相反，将与基准相等的元素放在左侧，用于区间中存在大量相同元素的情况 */
+template<typename T, typename Compare>
+T* partitionLeft(T *begin, T *end, Compare &comp){
+    T pivot = std::move(*begin);
+    T *first = begin, *last = end;
+
+    while(comp(pivot, *--last));
+    if(last + 1 == end){
+        while(first < last && !comp(pivot, *++first));
+    }else{
+        while(!comp(pivot, *++first));
+    }
+
+    while(first < last){
+        std::iter_swap(first, last);
+        while(comp(pivot, *--last));
+        while(!comp(pivot, *++first));
+    }
+
+    T *pivotPos = last;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return pivotPos;
+}
+
+template<typename T, typename Compare>
+void pdqLoop(T *begin, T *end, Compare &comp, int badAllowed, bool leftmost){
+    while(true){
+        const std::size_t size = static_cast<std::size_t>(end - begin);
+        if(size < PDQ_INSERTION){
+            if constexpr (std::is_arithmetic_v<T>) linearInsertionSort(begin, size, comp);
+            else binaryInsertionSort(begin, size, comp);
+            return;
+        }
+
+        /* 将基准放在*begin */
+        const std::size_t half = size / 2;
+        if(size > PDQ_NINTHER){
+            sort3(begin, begin + half, end - 1, comp);
+            sort3(begin + 1, begin + (half - 1), end - 2, comp);
+            sort3(begin + 2, begin + (half + 1), end - 3, comp);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+            std::iter_swap(begin, begin + half);
+        }else{
+            sort3(begin + half, begin, end - 1, comp);
+        }
+
+        /* 左侧相邻的元素(上一次的基准)不小于当前基准，说明当前区间中存在大量与基准相同的元素，将它们一次划分出去 */
+        if(!leftmost && !comp(*(begin - 1), *begin)){
+            begin = partitionLeft(begin, end, comp) + 1;
+            continue;
+        }
+
+        auto [pivotPos, alreadyPartitioned] = partitionRight(begin, end, comp);
+        const std::size_t left = static_cast<std::size_t>(pivotPos - begin);
+        const std::size_t right = static_cast<std::size_t>(end - (pivotPos + 1));
+
+        if(left < size / 8 || right < size / 8){
+            /* 划分严重失衡：多次发生时改用堆排序，否则打乱若干元素以破坏导致失衡的模式 */
+            if(--badAllowed == 0){
+                std::make_heap(begin, end, comp);
+                std::sort_heap(begin, end, comp);
+                return;
+            }
+            if(left >= PDQ_INSERTION){
+                std::iter_swap(begin, begin + left / 4);
+                std::iter_swap(pivotPos - 1, pivotPos - left / 4);
+            }
+            if(right >= PDQ_INSERTION){
+                std::iter_swap(pivotPos + 1, pivotPos + (1 + right / 4));
+                std::iter_swap(end - 1, end - right / 4);
+            }
+        }else if(alreadyPartitioned && partialInsertionSort(begin, pivotPos, comp)
+                 && partialInsertionSort(pivotPos + 1, end, comp)){
+            return;
+        }
+
+        pdqLoop(begin, pivotPos, comp, badAllowed, leftmost);
+        begin = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+template<typename T, typename Compare>
+void pdqSort(T *first, std::size_t n, Compare &comp){
+    if(n < 2) return;
+    int log2 = 0;
+    for(std::size_t m = n; m > 1; m /= 2) ++log2;
+    pdqLoop(first, first + n, comp, log2, true);
+}
+
+//===============Sorter===============
+template<typename T, std::size_t SZ, typename Compare = std::less<T>, SortStrategy = sortStrategy<T, Compare>(SZ)>
+struct Sorter;
+
+template<typename T, std::size_t SZ, typename Compare>
+struct Sorter<T, SZ, Compare, SortStrategy::Network>{
+    static constexpr SortStrategy strategy = SortStrategy::Network;
+
+    static void sort(T *data, Compare comp){
+        constexpr auto &network = SORTING_NETWORK<SZ>;
+        [&]<std::size_t... I>(std::index_sequence<I...>){
+            (compareSwap(data[network[I].lo], data[network[I].hi], comp), ...);
+        }(std::make_index_sequence<network.size()>{});
+    }
+};
+
+template<typename T, std::size_t SZ, typename Compare>
+struct Sorter<T, SZ, Compare, SortStrategy::Insertion>{
+    static constexpr SortStrategy strategy = SortStrategy::Insertion;
+    static void sort(T *data, Compare comp) { binaryInsertionSort(data, SZ, comp); }
+};
+
+template<typename T, std::size_t SZ, typename Compare>
+struct Sorter<T, SZ, Compare, SortStrategy::Radix>{
+    static constexpr SortStrategy strategy = SortStrategy::Radix;
+    static void sort(T *data, Compare) { radixSort<T, SZ>(data); }
+};
+
+template<typename T, std::size_t SZ, typename Compare>
+struct Sorter<T, SZ, Compare, SortStrategy::Pdq>{
+    static constexpr SortStrategy strategy = SortStrategy::Pdq;
+    static void sort(T *data, Compare comp) { pdqSort(data, SZ, comp); }
+};
+
+template<typename T, std::size_t SZ, typename Compare = std::less<T>>
+void sortArray(T (&arr)[SZ], Compare comp = Compare()){
+    Sorter<T, SZ, Compare>::sort(arr, comp);
+}
+
+template<typename T, std::size_t SZ, typename Compare = std::less<T>>
+void sortArray(std::array<T, SZ> &arr, Compare comp = Compare()){
+    Sorter<T, SZ, Compare>::sort(arr.data(), comp);
+}
+
+/* 返回已排序的数组中第一个不小于value的元素的下标，不存在时返回SZ */
+template<typename T, std::size_t SZ, typename Compare = std::less<T>>
+std::size_t lowerBound(const T (&arr)[SZ], const T &value, Compare comp = Compare()){
+    return branchlessLowerBound(arr, SZ, value, comp);
+}
+
+template<typename T, std::size_t SZ, typename Compare = std::less<T>>
+std::size_t lowerBound(const std::array<T, SZ> &arr, const T &value, Compare comp = Compare()){
+    return branchlessLowerBound(arr.data(), SZ, value, comp);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef AGGREGATE_FIELDS_HPP
+#define AGGREGATE_FIELDS_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 《聚合类型的成员》
+ * C++17没有反射，但聚合类型的成员可以借助SFINAE和结构化绑定获得：
+ *   1.fieldCount：AnyField可以转换为任意类型，以N个AnyField进行花括号初始化，能够成功的最大N即成员的数量。
+ *   2.tieFields：根据成员的数量选择相应个数的结构化绑定，以引用组成的元组返回所有成员。
+ *   3.原始数组成员会发生花括号省略，使fieldCount大于成员的数量，此时tieable<T>为false，不能使用tieFields。
+ * serializer.hpp用它逐个成员编码聚合类型，ch1.13的soa_vector.hpp用它把聚合类型的成员拆分到不同的数组中。
+ */
+constexpr std::size_t MAX_FIELDS = 12;
+
+/* 可以转换为任意类型，用于检测聚合类型能否以N个初始值进行初始化 */
+struct AnyField{
+    template<typename T>
+    operator T() const;
+};
+
+template<typename T, std::size_t... I>
+auto braceConstructible(std::index_sequence<I...>) -> decltype(T{(void(I), AnyField())...}, std::true_type());
+
+template<typename T>
+std::false_type braceConstructible(...);
+
+/* 能够接受的初始值的最大数量即成员的数量。初始值可以直接转换为成员的类型，因此嵌套的聚合成员不会发生花括号省略 */
+template<typename T, std::size_t N = 0>
+constexpr std::size_t fieldCount(){
+    if constexpr (N > MAX_FIELDS) return N;
+    else if constexpr (decltype(braceConstructible<T>(std::make_index_sequence<N + 1>()))::value) return fieldCount<T, N + 1>();
+    else return N;
+}
+
+/* 每个初始值都带有花括号时不会发生花括号省略，原始数组成员只占一个初始值，因此结果与fieldCount不同时说明T含有原始数组成员 */
+template<typename T, std::size_t... I>
+auto bracedConstructible(std::index_sequence<I...>) -> decltype(T{{(void(I), AnyField())}...}, std::true_type());
+
+template<typename T>
+std::false_type bracedConstructible(...);
+
+template<typename T, std::size_t N = 0>
+constexpr std::size_t bracedFieldCount(){
+    if constexpr (N > MAX_FIELDS) return N;
+    else if constexpr (decltype(bracedConstructible<T>(std::make_index_sequence<N + 1>()))::value) return bracedFieldCount<T, N + 1>();
+    else return N;
+}
+
+/* tieFields能否取出T的所有成员 */
+template<typename T>
+constexpr bool tieable = fieldCount<T>() <= MAX_FIELDS && fieldCount<T>() == bracedFieldCount<T>();
+
+#define AGGREGATE_FIELDS_CASE(n, ...)                      \
+    else if constexpr (count == n){                         \
+        auto &[__VA_ARGS__] = obj;                          \
+        return std::forward_as_tuple(__VA_ARGS__);          \
+    }
+
+/* 以引用组成的元组返回聚合类型的所有成员 */
+template<typename T>
+auto tieFields(T &obj){
+    constexpr std::size_t count = fieldCount<std::remove_const_t<T>>();
+    static_assert(count <= MAX_FIELDS, "too many fields in aggregate");
+    if constexpr (count == 0) return std::tuple<>();
+    AGGREGATE_FIELDS_CASE(1, a)
+    AGGREGATE_FIELDS_CASE(2, a, b)
+    AGGREGATE_FIELDS_CASE(3, a, b, c)
+    AGGREGATE_FIELDS_CASE(4, a, b, c, d)
+    AGGREGATE_FIELDS_CASE(5, a, b, c, d, e)
+    AGGREGATE_FIELDS_CASE(6, a, b, c, d, e, f)
+    AGGREGATE_FIELDS_CASE(7, a, b, c, d, e, f, g)
+    AGGREGATE_FIELDS_CASE(8, a, b, c, d, e, f, g, h)
+    AGGREGATE_FIELDS_CASE(9, a, b, c, d, e, f, g, h, i)
+    AGGREGATE_FIELDS_CASE(10, a, b, c, d, e, f, g, h, i, j)
+    AGGREGATE_FIELDS_CASE(11, a, b, c, d, e, f, g, h, i, j, k)
+    AGGREGATE_FIELDS_CASE(12, a, b, c, d, e, f, g, h, i, j, k, l)
+}
+
+#undef AGGREGATE_FIELDS_CASE
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * 《逐个元素编码与serialize》
+ * 分别序列化std::vector<int>、std::vector<std::string>以及包含嵌套聚合类型的std::vector<Order>，输出每秒写出的字节数(GB/s)：
+ *   1.elementwise：与原先的快照代码相同，所有范围都逐个元素编码，聚合类型逐个成员编码，不区分元素是否可以平凡拷贝。
+ *   2.serialize：可以平凡拷贝的对象和元素可以平凡拷贝的连续范围都通过一次write写出。
+ * 两者都写入同一个反复使用的BufferSink。另外测试写入文件的两种方式：serialize到BufferSink后调用一次write，以及serialize到FdSink后以writev写出，
+ * 后者不拷贝较长的连续范围。文件在每次写入前被截断，数据进入页缓存，不包括写回磁盘的时间。(/dev/null不会读取数据，因此不适合测试writev。)
+ * 用法：bench_serializer.exe [int的数量] [字符串的数量] [Order的数量]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "serializer.hpp"
+
+struct Fill{
+    double price;
+    int quantity;
+    int venue;
+};
+
+struct Meta{
+    long long timestamp;
+    std::string account;
+};
+
+struct Order{
+    int id;
+    std::string symbol;
+    std::vector<Fill> fills;
+    Meta meta;
+};
+
+//===============逐个元素编码===============
+template<typename Sink, typename T>
+void serializeElementwise(Sink &sink, const T &value){
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>){
+        sink.write(&value, sizeof(T));
+    }else if constexpr (isRange<T>){
+        writeCount(sink, value.size());
+        for(const auto &element : value) serializeElementwise(sink, element);
+    }else{
+        std::apply([&sink](const auto&... fields){ (serializeElementwise(sink, fields), ...); }, tieFields(value));
+    }
+}
+
+//===============计时===============
+template<typename F>
+double gbPerSecond(std::size_t bytes, int reps, F &&f){
+    auto begin = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; ++r) f();
+    std::chrono::duration<double> s = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(bytes) * reps / s.count() / 1e9;
+}
+
+template<typename T>
+void run(const char *name, const T &value, int reps, int file){
+    BufferSink sink;
+    serialize(sink, value);       //预先分配缓冲区
+    const std::size_t bytes = sink.size();
+
+    const double elementwise = gbPerSecond(bytes, reps, [&]{ sink.clear(); serializeElementwise(sink, value); });
+    const std::size_t check = sink.size();
+    const double bulk = gbPerSecond(bytes, reps, [&]{ sink.clear(); serialize(sink, value); });
+    auto rewind = [file]{
+        if(::ftruncate(file, 0) != 0 || ::lseek(file, 0, SEEK_SET) != 0) std::cout << "rewind failed" << std::endl;
+    };
+    const double write = gbPerSecond(bytes, reps, [&]{
+        rewind();
+        sink.clear();
+        serialize(sink, value);
+        if(::write(file, sink.data(), sink.size()) != static_cast<ssize_t>(sink.size())) std::cout << "write failed" << std::endl;
+    });
+    const double writev = gbPerSecond(bytes, reps, [&]{
+        rewind();
+        FdSink fd(file);
+        serialize(fd, value);
+        fd.flush();
+    });
+
+    std::cout << name << "\t" << bytes / 1000000.0 << "\t" << elementwise << "\t" << bulk << "\t" << write << "\t" << writev
+              << "\t(check " << check - sink.size() << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    std::size_t ints = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t strings = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    std::size_t orders = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 200000;
+
+    std::mt19937 rng(42);
+    std::vector<int> numbers(ints);
+    for(int &x : numbers) x = static_cast<int>(rng());
+
+    std::vector<std::string> words(strings);
+    for(std::string &w : words) w.assign(8 + rng() % 25, static_cast<char>('a' + rng() % 26));
+
+    std::vector<Order> book(orders);
+    for(std::size_t i = 0; i < orders; ++i){
+        Order &o = book[i];
+        o.id = static_cast<int>(i);
+        o.symbol = "SYM" + std::to_string(rng() % 5000);
+        o.fills.resize(1 + rng() % 16);
+        for(Fill &f : o.fills) f = Fill{100.0 + (rng() % 1000) / 100.0, static_cast<int>(rng() % 500), static_cast<int>(rng() % 8)};
+        o.meta = Meta{static_cast<long long>(rng()), "account-" + std::to_string(rng() % 100)};
+    }
+
+    const char *path = "bench_serializer.tmp";
+    const int file = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    std::cout << "data\tMB\telementwise(GB/s)\tserialize(GB/s)\tbuffer+write(GB/s)\tFdSink+writev(GB/s)" << std::endl;
+    run("vector<int>", numbers, 10, file);
+    run("vector<string>", words, 10, file);
+    run("vector<Order>", book, 10, file);
+    ::close(file);
+    ::unlink(path);
+}
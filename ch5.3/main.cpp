@@ -0,0 +1,139 @@
+/**
+ * 《SFINAE》
+ * 1.当候选函数中包含函数模板时，编译器需要先以推断出的类型替换函数模板的参数列表和返回值类型中的模板参数。替换失败的函数模板只是被简单地忽略，
+ *   而不会导致错误，这个原则被称为SFINAE(Substitution Failure Is Not An Error)。替换只涉及函数声明，不涉及函数体。[例1]
+ * 2.可以添加一个参数为省略号的普通函数len(...)作为回落方案，当所有函数模板都因为替换失败而被忽略时，编译器会选择该函数。[例2]
+ * 3.借助后置返回类型、decltype和逗号表达式，可以将函数体中需要使用的表达式放入函数声明中，使编译器在替换阶段就检查这些表达式是否合法。逗号表达式中
+ *   除最后一个表达式之外的每个表达式都需要转换为void，以免受到用户重载的逗号操作符的影响。[例3]
+ * 4.serializer.hpp使用同样的方式检测类型是否为连续存放的范围、其他范围、类似元组的类型或聚合类型，并据此选择序列化的方式。[例4]
+ */
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+#include "serializer.hpp"
+
+//===============例1===============
+/* 要求参数是一个原始数组 */
+template<typename T, unsigned N>
+std::size_t len1(const T (&arg)[N]){
+    return N;
+}
+
+/* 要求参数的类型T具有类型成员size_type */
+template<typename T>
+typename T::size_type len1(const T &arg){
+    return arg.size();
+}
+
+void func1(){
+    int arr[10];
+    std::vector<int> vec(10);
+    std::cout << len1(arr) << std::endl;      //选中第一个函数模板
+    std::cout << len1("Hello") << std::endl;  //选中第一个函数模板
+    std::cout << len1(vec) << std::endl;      //选中第二个函数模板
+
+    //int *p;
+    //len1(p);       //错误，两个函数模板都因为替换失败而被忽略，没有匹配的函数
+}
+
+//===============例2===============
+template<typename T, unsigned N>
+std::size_t len2(const T (&arg)[N]){
+    return N;
+}
+
+template<typename T>
+typename T::size_type len2(const T &arg){
+    return arg.size();
+}
+
+/* 回落方案 */
+std::size_t len2(...){
+    return 0;
+}
+
+void func2(){
+    int *p = nullptr;
+    std::cout << len2(p) << std::endl;   //OK，返回0
+
+    //std::allocator<int> alloc;
+    //len2(alloc);   //错误，第二个函数模板替换成功，但std::allocator没有成员函数size
+}
+
+//===============例3===============
+template<typename T>
+auto len3(const T &arg) -> decltype((void)(arg.size()), typename T::size_type()){
+    return arg.size();
+}
+
+std::size_t len3(...){
+    return 0;
+}
+
+struct RealType{};
+struct UserDef{
+    int operator,(const RealType &rt){
+        return 0;
+    }
+};
+
+void func3(){
+    std::allocator<int> alloc;
+    std::vector<int> vec(5);
+    std::cout << len3(alloc) << std::endl;   //替换阶段就发现allocator没有成员size，因此选择了len3(...)
+    std::cout << len3(vec) << std::endl;     //OK
+
+    using type1 = decltype(UserDef(), RealType());
+    using type2 = decltype((void)UserDef(), RealType());
+    std::cout << typeid(type1).name() << std::endl;   //int
+    std::cout << typeid(type2).name() << std::endl;   //RealType
+}
+
+//===============例4===============
+struct Point{ int x; int y; };
+struct Shape{ std::string name; std::vector<Point> points; };
+struct Label{ const char *text; int size; };
+
+/* 含有原始数组成员，无法逐个检查成员，确认其中没有指针之后将其加入白名单 */
+struct Matrix{ double m[2][2]; int rank; };
+template<>
+struct BitwiseSerializable<Matrix> : std::true_type{};
+
+void func4(){
+    static_assert(isContiguous<std::vector<int>> && !isContiguous<std::allocator<int>>, "contiguous range");
+    static_assert(fieldCount<Shape>() == 2, "two fields");
+
+    const std::vector<Shape> shapes = {{"triangle", {{0, 0}, {1, 0}, {0, 1}}}, {"dot", {{5, 5}}}};
+    BufferSink sink;
+    serialize(sink, shapes);    //std::vector<Point>通过一次write写出
+
+    std::vector<Shape> copy;
+    BufferSource source(sink.data(), sink.size());
+    deserialize(source, copy);
+    std::cout << sink.size() << " bytes, " << copy[0].name << " " << copy[0].points.size() << " " << copy[1].points[0].x << std::endl;
+
+    /* std::string_view可以平凡拷贝，但字符不在对象内部，因此按照连续范围写出字符，读取时需要使用std::string这样拥有数据的类型 */
+    static_assert(isBitwise<Point> && isBitwise<std::array<Point, 2>> && !isBitwise<std::string_view>, "bitwise types");
+    static_assert(!isBitwise<Label>, "an aggregate with a pointer member is not bitwise");
+    static_assert(!isBitwise<std::optional<std::string_view>> && isBitwise<Matrix>, "only whitelisted classes are bitwise");
+    const std::string text = "hello";
+    BufferSink viewSink;
+    serialize(viewSink, std::string_view(text));
+    std::string viewCopy;
+    BufferSource viewSource(viewSink.data(), viewSink.size());
+    deserialize(viewSource, viewCopy);
+    std::cout << viewSink.size() << " bytes, " << viewCopy << " " << (viewCopy == text) << std::endl;
+}
+
+int main(void){
+    func1();
+    func2();
+    func3();
+    func4();
+}
@@ -0,0 +1,314 @@
+#ifndef SERIALIZER_HPP
+#define SERIALIZER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits.h>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "aggregate_fields.hpp"
+
+/**
+ * 《基于SFINAE检测的二进制序列化》
+ * main.cpp中的len(const T&) -> decltype((void)arg.size(), typename T::size_type())借助表达式SFINAE在替换阶段检查类型是否具有某种能力。serialize
+ * 以同样的方式检测参数的类型，并按照以下顺序选择编码方式：
+ *   1.对象的字节包含全部内容的类型(整数、浮点数、枚举以及只包含这些成员的结构体、std::array等，见isBitwise)：整个对象通过一次write写出。
+ *     指针不能序列化，含有指针成员的聚合类型会在编译时报错。
+ *   2.连续存放的范围：具有data()和size()，并且*data()的类型就是value_type(例如std::vector、std::string)。先写出64位的元素个数，如果value_type可以
+ *     平凡拷贝，那么所有元素通过一次write写出，否则逐个元素编码。
+ *   3.其他范围：具有begin()、end()和size()(例如std::list、std::map)，写出元素个数后逐个元素编码。
+ *   4.类似元组的类型：std::tuple_size<T>有定义(例如std::pair、std::tuple)，逐个成员编码。
+ *   5.聚合类型：通过aggregate_fields.hpp中的tieFields取出所有成员(最多MAX_FIELDS个)，逐个成员编码。成员不能是C风格数组。
+ * 不属于以上任何一种的类型在编译时报错。
+ * 数据写入Sink，Sink只需提供write(const void*, std::size_t)：
+ *   1.BufferSink将数据memcpy到一段连续的内存中。
+ *   2.FdSink用于写入文件：较长的数据只记录指向原对象的iovec而不拷贝，较短的数据拷贝到暂存块中，flush时通过writev一次系统调用写出所有的iovec
+ *     (超过IOV_MAX时分批写出)。调用flush之前被序列化的对象必须保持有效并且不能被修改。
+ * deserialize按照相同的规则从BufferSource中读取数据，数据不足时抛出std::out_of_range。整数和浮点数以本机字节序编码，因此数据只能由相同平台的程序读取。
+ */
+
+//===============检测===============
+/* 与len的写法相同：逗号表达式中的每个表达式都必须合法，替换才会成功 */
+template<typename T>
+auto hasContiguousData(const T &arg) -> decltype((void)arg.data(), (void)arg.size(),
+                                                 std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(*arg.data())>>, typename T::value_type>());
+std::false_type hasContiguousData(...);
+
+template<typename T>
+auto hasRange(const T &arg) -> decltype((void)std::begin(arg), (void)std::end(arg), (void)arg.size(), std::true_type());
+std::false_type hasRange(...);
+
+template<typename T>
+auto hasTupleSize(const T &) -> decltype((void)std::tuple_size<T>::value, std::true_type());
+std::false_type hasTupleSize(...);
+
+template<typename T>
+auto hasResize(T &arg) -> decltype((void)arg.resize(std::size_t()), std::true_type());
+std::false_type hasResize(...);
+
+template<typename T>
+auto hasEmplaceBack(T &arg) -> decltype((void)arg.emplace_back(std::declval<typename T::value_type>()), std::true_type());
+std::false_type hasEmplaceBack(...);
+
+template<typename T>
+constexpr bool isContiguous = decltype(hasContiguousData(std::declval<const T&>()))::value;
+
+template<typename T>
+constexpr bool isRange = decltype(hasRange(std::declval<const T&>()))::value;
+
+template<typename T>
+constexpr bool isTupleLike = decltype(hasTupleSize(std::declval<const T&>()))::value;
+
+template<typename T>
+constexpr bool isResizable = decltype(hasResize(std::declval<T&>()))::value;
+
+template<typename T>
+constexpr bool isBackInsertable = decltype(hasEmplaceBack(std::declval<T&>()))::value;
+
+//===============按字节拷贝===============
+/**
+ * 可以平凡拷贝只说明按字节拷贝对象是合法的，不说明对象的字节包含了它的全部内容：指针、std::string_view、std::span以及含有指针成员的结构体都
+ * 可以平凡拷贝，但它们引用的数据在对象之外。因此只有以下类型按字节写出：
+ *   1.可以平凡拷贝的非指针标量(整数、浮点数、枚举)。
+ *   2.元素按字节写出的原始数组和std::array。范围中只有聚合类型的元素保存在对象内部，std::string_view、std::span等不是聚合类型，按照连续范围编码。
+ *   3.所有成员都按字节写出的聚合类型。
+ *   4.特例化BitwiseSerializable<T>为std::true_type的可以平凡拷贝的类型。其他类(例如std::optional<std::string_view>)、联合体，以及含有原始数组
+ *     成员或者成员超过MAX_FIELDS个的聚合类型无法检查其成员，不能假定其中没有指针，只有由使用者确认之后才按字节写出，否则序列化时编译失败。
+ */
+template<typename T>
+struct BitwiseSerializable : std::false_type{};
+
+template<typename T>
+constexpr bool bitwiseType();
+
+template<typename... F>
+constexpr bool bitwiseFields(std::tuple<F&...>*) { return (bitwiseType<std::remove_const_t<F>>() && ...); }
+
+template<typename T>
+constexpr bool bitwiseType(){
+    if constexpr (!std::is_trivially_copyable_v<T> || std::is_pointer_v<T> || std::is_member_pointer_v<T>) return false;
+    else if constexpr (std::is_scalar_v<T>) return true;
+    else if constexpr (std::is_array_v<T>) return bitwiseType<std::remove_extent_t<T>>();
+    else if constexpr (isRange<T>) return std::is_aggregate_v<T> && bitwiseType<typename T::value_type>();
+    else if constexpr (BitwiseSerializable<T>::value) return true;
+    else if constexpr (std::is_aggregate_v<T> && !std::is_union_v<T> && tieable<T>) return bitwiseFields(static_cast<decltype(tieFields(std::declval<T&>()))*>(nullptr));
+    else return false;
+}
+
+template<typename T>
+constexpr bool isBitwise = bitwiseType<T>();
+
+//===============Sink与Source===============
+/* 容量按倍数增长，新增的部分不初始化，因此每次write只有一次memcpy */
+class BufferSink{
+public:
+    void write(const void *data, std::size_t n){
+        if(m_size + n > m_capacity) grow(m_size + n);
+        std::memcpy(m_buf.get() + m_size, data, n);
+        m_size += n;
+    }
+
+    void reserve(std::size_t n) { if(n > m_capacity) grow(n); }
+    void clear() { m_size = 0; }
+    const char* data() const { return m_buf.get(); }
+    std::size_t size() const { return m_size; }
+
+private:
+    void grow(std::size_t required){
+        const std::size_t capacity = std::max(required, m_capacity * 2);
+        std::unique_ptr<char[]> buf(new char[capacity]);
+        if(m_size > 0) std::memcpy(buf.get(), m_buf.get(), m_size);
+        m_buf = std::move(buf);
+        m_capacity = capacity;
+    }
+
+    std::unique_ptr<char[]> m_buf;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = 0;
+};
+
+class FdSink{
+public:
+    static constexpr std::size_t BORROW_THRESHOLD = 256;     //不短于该长度的数据不拷贝
+    static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+    explicit FdSink(int fd) : m_fd(fd) {}
+
+    void write(const void *data, std::size_t n){
+        if(n == 0) return;
+        if(n >= BORROW_THRESHOLD){
+            push(data, n);
+            return;
+        }
+        if(m_blocks.empty() || m_blockUsed + n > BLOCK_SIZE){
+            m_blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            m_blockUsed = 0;
+        }
+        char *dest = m_blocks.back().get() + m_blockUsed;
+        std::memcpy(dest, data, n);
+        m_blockUsed += n;
+        push(dest, n);
+    }
+
+    /* 写出所有数据，失败时抛出std::system_error */
+    void flush(){
+        std::size_t first = 0;
+        while(first < m_iov.size()){
+            const int count = static_cast<int>(std::min<std::size_t>(m_iov.size() - first, IOV_MAX));
+            const ssize_t written = ::writev(m_fd, m_iov.data() + first, count);
+            if(written < 0){
+                if(errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "writev");
+            }
+
+            /* 跳过已经完整写出的iovec，部分写出的iovec调整起点后重试 */
+            std::size_t left = static_cast<std::size_t>(written);
+            while(first < m_iov.size() && left >= m_iov[first].iov_len) left -= m_iov[first++].iov_len;
+            if(left > 0){
+                m_iov[first].iov_base = static_cast<char*>(m_iov[first].iov_base) + left;
+                m_iov[first].iov_len -= left;
+            }
+        }
+        m_iov.clear();
+        m_blocks.clear();
+        m_blockUsed = 0;
+    }
+
+    std::size_t pending() const { return m_iov.size(); }
+
+private:
+    /* 与上一个iovec相邻时直接合并 */
+    void push(const void *data, std::size_t n){
+        if(!m_iov.empty()){
+            iovec &last = m_iov.back();
+            if(static_cast<const char*>(last.iov_base) + last.iov_len == data){
+                last.iov_len += n;
+                return;
+            }
+        }
+        m_iov.push_back(iovec{const_cast<void*>(data), n});
+    }
+
+    int m_fd;
+    std::vector<iovec> m_iov;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::size_t m_blockUsed = 0;
+};
+
+class BufferSource{
+public:
+    BufferSource(const char *data, std::size_t n) : m_pos(data), m_end(data + n) {}
+
+    void read(void *dest, std::size_t n){
+        if(static_cast<std::size_t>(m_end - m_pos) < n) throw std::out_of_range("BufferSource: not enough data");
+        std::memcpy(dest, m_pos, n);
+        m_pos += n;
+    }
+
+    std::size_t remaining() const { return static_cast<std::size_t>(m_end - m_pos); }
+
+private:
+    const char *m_pos;
+    const char *m_end;
+};
+
+//===============serialize===============
+template<typename T>
+struct AlwaysFalse : std::false_type{};
+
+template<typename Sink>
+void writeCount(Sink &sink, std::size_t n){
+    const std::uint64_t count = n;
+    sink.write(&count, sizeof(count));
+}
+
+template<typename Sink, typename T>
+void serialize(Sink &sink, const T &value){
+    if constexpr (isBitwise<T>){
+        sink.write(&value, sizeof(T));
+    }else if constexpr (isContiguous<T>){
+        using V = typename T::value_type;
+        writeCount(sink, value.size());
+        if constexpr (isBitwise<V>){
+            sink.write(value.data(), value.size() * sizeof(V));
+        }else{
+            for(const V &element : value) serialize(sink, element);
+        }
+    }else if constexpr (isRange<T>){
+        writeCount(sink, value.size());
+        for(const auto &element : value) serialize(sink, element);
+    }else if constexpr (isTupleLike<T>){
+        std::apply([&sink](const auto&... elements){ (serialize(sink, elements), ...); }, value);
+    }else if constexpr (std::is_aggregate_v<T> && !std::is_union_v<T> && tieable<T>){
+        std::apply([&sink](const auto&... fields){ (serialize(sink, fields), ...); }, tieFields(value));
+    }else{
+        static_assert(AlwaysFalse<T>::value, "serialize: unsupported type, specialize BitwiseSerializable<T> if its bytes hold all of its content");
+    }
+}
+
+//===============deserialize===============
+/* std::map等容器的value_type为std::pair<const K, V>，读取时需要去掉const */
+template<typename T>
+struct Mutable{ using type = std::remove_const_t<T>; };
+
+template<typename K, typename V>
+struct Mutable<std::pair<const K, V>>{ using type = std::pair<K, V>; };
+
+template<typename Source>
+std::size_t readCount(Source &source){
+    std::uint64_t count = 0;
+    source.read(&count, sizeof(count));
+    return static_cast<std::size_t>(count);
+}
+
+template<typename Source, typename T>
+void deserialize(Source &source, T &value){
+    if constexpr (isBitwise<T>){
+        source.read(&value, sizeof(T));
+    }else if constexpr (isContiguous<T>){
+        using V = typename T::value_type;
+        const std::size_t n = readCount(source);
+        static_assert(isResizable<T> || std::is_aggregate_v<T>, "deserialize: cannot read into a view such as std::string_view, use an owning type");
+        if constexpr (isResizable<T>){
+            if(isBitwise<V> && n > source.remaining() / sizeof(V)) throw std::out_of_range("deserialize: not enough data");
+            value.resize(n);
+        }else if(n != value.size()){
+            throw std::out_of_range("deserialize: size mismatch");     //例如std::array
+        }
+
+        if constexpr (isBitwise<V>){
+            source.read(value.data(), n * sizeof(V));
+        }else{
+            for(V &element : value) deserialize(source, element);
+        }
+    }else if constexpr (isRange<T>){
+        using V = typename Mutable<typename T::value_type>::type;
+        const std::size_t n = readCount(source);
+        value.clear();
+        for(std::size_t i = 0; i < n; ++i){
+            V element{};
+            deserialize(source, element);
+            if constexpr (isBackInsertable<T>) value.emplace_back(std::move(element));
+            else value.insert(std::move(element));
+        }
+    }else if constexpr (isTupleLike<T>){
+        std::apply([&source](auto&... elements){ (deserialize(source, elements), ...); }, value);
+    }else if constexpr (std::is_aggregate_v<T> && !std::is_union_v<T> && tieable<T>){
+        std::apply([&source](auto&... fields){ (deserialize(source, fields), ...); }, tieFields(value));
+    }else{
+        static_assert(AlwaysFalse<T>::value, "deserialize: unsupported type, specialize BitwiseSerializable<T> if its bytes hold all of its content");
+    }
+}
+
+#endif